@@ -8,46 +8,30 @@
 #include <stdio.h>
 #include <string.h>
 #include "highscore.h"
+#include "power.h"
+#include "input.h"
+#include "telemetry.h"
+#include "logger.h"
+#include "fbstream.h"
+#include "effects.h"
+#include "ui.h"
+#include "deadline.h"
+#include "config.h"
+#include "console.h"
+#include "snapshot.h"
+#include "boot.h"
+#include "profiler.h"
 
 
 #define LED_B_PIN 12    // Usado apenas o LED azul
 #define JOYSTICK_BTN 22
 #define LED_MATRIX_PIN 7
 
-#define PAUSE_BTN 5     // Botão A para pausar (GPIO 5)
-#define SOUND_BTN 6     // Botão B para mutar/desmutar som (GPIO 6)
-
 #define MAX_HIGH_SCORES 3
 #define MAX_NAME_LENGTH 16
 
-
-// Variáveis globais de estado
-volatile bool game_paused = false;
-volatile bool game_sound_enabled = true;
-
-// Variáveis para debouncing (em microsegundos)
-volatile uint32_t last_pause_interrupt_time = 0;
-volatile uint32_t last_sound_interrupt_time = 0;
-#define DEBOUNCE_TIME 200000 // 200 ms
-
-// Callback de interrupção para PAUSE_BTN e SOUND_BTN com debouncing
-void gpio_callback(uint gpio, uint32_t events) {
-    uint32_t current_time = time_us_32();
-    
-    if (gpio == PAUSE_BTN && (events & GPIO_IRQ_EDGE_FALL)) {
-        if (current_time - last_pause_interrupt_time < DEBOUNCE_TIME)
-            return;
-        last_pause_interrupt_time = current_time;
-        game_paused = !game_paused;
-    }
-    
-    if (gpio == SOUND_BTN && (events & GPIO_IRQ_EDGE_FALL)) {
-        if (current_time - last_sound_interrupt_time < DEBOUNCE_TIME)
-            return;
-        last_sound_interrupt_time = current_time;
-        game_sound_enabled = !game_sound_enabled;
-    }
-}
+// Intervalo máximo entre duas passagens pelas tarefas ociosas (telemetria, log)
+#define IDLE_TASK_PERIOD_MS 100
 
 void setup_blue_led() {
     gpio_set_function(LED_B_PIN, GPIO_FUNC_PWM);
@@ -58,103 +42,107 @@ void setup_blue_led() {
 }
 
 int main() {
-    stdio_init_all();
-    init_high_scores();
+    // Clock do modo ativo (exigido pela PIO da matriz), ajustado uma única vez
+    // antes de qualquer periférico calcular seus divisores
+    set_sys_clock_khz(POWER_ACTIVE_KHZ, false);
+    boot_mark(BOOT_PHASE_CLOCK);
 
+    stdio_init_all();
     setvbuf(stdin, NULL, _IONBF, 0);
+    boot_mark(BOOT_PHASE_STDIO);
 
-    sleep_ms(2000);
+    init_high_scores();
+    // Parâmetros ajustáveis (cópia salva na flash ou padrões)
+    config_init();
+    boot_mark(BOOT_PHASE_CONFIG);
 
     setup_blue_led();
 
     // Inicializa o display OLED via I2C (SDA=14, SCL=15)
-    i2c_init(i2c1, 100 * 1000);
+    i2c_init(i2c1, config.i2c_hz);
     gpio_set_function(14, GPIO_FUNC_I2C);
     gpio_set_function(15, GPIO_FUNC_I2C);
     gpio_pull_up(14);
     gpio_pull_up(15);
     ssd1306_t display;
-    ssd1306_init(&display, 128, 64, false, 0x3C, i2c1);
+    ssd1306_init(&display, SSD1306_WIDTH, SSD1306_HEIGHT, false, 0x3C, i2c1);
     ssd1306_config(&display);
+    // Captura cada tela enviada para o streaming do framebuffer
+    display.send_hook = fbstream_capture;
+    fbstream_set_enabled(FBSTREAM_ENABLED_AT_BOOT);
+    boot_mark(BOOT_PHASE_DISPLAY);
 
     // Inicializa o ADC para o joystick (GPIO26 e GPIO27)
     adc_init();
     adc_gpio_init(26);
     adc_gpio_init(27);
-
-    // Inicializa o botão do joystick (GPIO22)
-    gpio_init(JOYSTICK_BTN);
-    gpio_set_dir(JOYSTICK_BTN, GPIO_IN);
-    gpio_pull_up(JOYSTICK_BTN);
-
-    // Inicializa o botão de pausa (GPIO5)
-    gpio_init(PAUSE_BTN);
-    gpio_set_dir(PAUSE_BTN, GPIO_IN);
-    gpio_pull_up(PAUSE_BTN);
-    // Habilita a interrupção para PAUSE_BTN na borda de descida
-    gpio_set_irq_enabled_with_callback(PAUSE_BTN, GPIO_IRQ_EDGE_FALL, true, gpio_callback);
-
-    // Inicializa o botão de som (GPIO6)
-    gpio_init(SOUND_BTN);
-    gpio_set_dir(SOUND_BTN, GPIO_IN);
-    gpio_pull_up(SOUND_BTN);
-    // Habilita a interrupção para SOUND_BTN na borda de descida
-    gpio_set_irq_enabled(SOUND_BTN, GPIO_IRQ_EDGE_FALL, true);
+    // Amostra o joystick a cada INPUT_SAMPLE_PERIOD_MS e enfileira as curvas
+    input_init();
 
     // Inicializa a matriz de LEDs
     pio_t led_matrix;
     led_matrix.pio = pio0;
     init_pio_routine(&led_matrix, LED_MATRIX_PIN);
 
+    // Efeitos de LED (matriz e LED azul) tocados por timer, sem bloquear o laço
+    effects_init(&led_matrix, LED_B_PIN);
+
+    // Gerência de energia: reduz o clock nas pausas e esperas e restaura os divisores
+    power_init(&led_matrix, i2c1, config.i2c_hz, LED_B_PIN);
+
+    // Motor de áudio (DMA + PWM): música e efeitos sem bloquear o laço
+    sound_init();
+
+    // Telemetria binária pelo USB CDC (drenada no tempo ocioso do laço)
+    telemetry_init();
+    // Perfilador por amostragem (só com -DSNAKE_PROFILER=ON; taxa de SNAKE_PROFILER_HZ)
+    profiler_start(PROFILER_HZ_AT_BOOT);
+    boot_mark(BOOT_PHASE_PERIPHERALS);
+
     srand(time_us_32());
 
-     
     SnakeGame game;
+    snake_set_players(&game, SNAKE_VERSUS_AT_BOOT ? 2 : 1);
+    snake_set_level(&game, 0);
     snake_init(&game);
+    // Jogo interrompido numa pausa (ex.: falta de energia): volta de onde parou
+    bool resumed = snapshot_restore(&game);
+    if (resumed)
+        input_reset(game.snakes[0].direction);
+
+    // Telas e botões (A = pausa, B = som, joystick = continuar) orientados a eventos
+    ui_init(&game, &display, &led_matrix);
+    if (resumed)
+        ui_start_paused();
+    boot_mark(BOOT_PHASE_GAME);
+
+    // Watchdog e monitor de prazos: ligado por último, já com o laço pronto
+    deadline_init();
 
     while (true) {
-        if (game_paused) {
-            ssd1306_fill(&display, 0);
-            ssd1306_draw_string(&display, "PAUSE", 44, 28);
-            ssd1306_send_data(&display);
-            sleep_ms(100);
-            continue;
-        }
-
-        snake_update_direction(&game);
-        snake_update(&game, &led_matrix);
-        snake_draw(&game, &display);
-
-        if (game_sound_enabled) {
-            sound_play_background_note();
-        }
-
-        if (game.game_over_flag) {
-            if (game_sound_enabled) {
-                sound_play_explosion_sound();
-            }
-            // Exibe a tela de Game Over (mantendo a animação já implementada)
-            snake_game_over_screen(&display, &led_matrix);
-
-            // Verifica se o jogador obteve um novo recorde e, se sim, atualiza o placar.
-           update_high_scores(&display, game.score);
-
-            // Exibe o placar atualizado
-            display_scoreboard(&display);
-
-            // Aguarda até o botão do joystick (GPIO22) ser pressionado para reiniciar
-            while (gpio_get(JOYSTICK_BTN)) {
-                sleep_ms(100);
-            }
-            while (!gpio_get(JOYSTICK_BTN)) {
-                sleep_ms(100);
-            }
-            // Reinicia o jogo
-            snake_init(&game);
-        }
-        
-        sleep_ms(FRAME_DELAY);
+        // Trabalho limitado do estado atual (um quadro do jogo, uma tela, ...)
+        deadline_stage(DEADLINE_STAGE_UI);
+        absolute_time_t next = ui_step();
+        boot_mark(BOOT_PHASE_FIRST_FRAME);  // Só a primeira volta conta
+
+        // Tarefas ociosas, em qualquer tela
+        deadline_stage(DEADLINE_STAGE_IDLE);
+        fbstream_poll();
+        profiler_poll();
+        telemetry_poll();
+        // Enquanto um host pode estar abrindo o terminal, o log do boot espera
+        if (!boot_usb_poll())
+            logger_drain();
+        console_poll();
+
+        // Dorme até o próximo passo ou até chegar um evento
+        absolute_time_t idle = make_timeout_time_ms(IDLE_TASK_PERIOD_MS);
+        if (absolute_time_diff_us(idle, next) > 0)
+            next = idle;
+        deadline_stage(DEADLINE_STAGE_SLEEP);
+        power_sleep_until(next, ui_event_pending);
+
+        // Volta completa: só aqui o watchdog é alimentado
+        deadline_loop_done();
     }
-    
-    return 0;
-}
\ No newline at end of file
+}
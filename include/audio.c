@@ -0,0 +1,267 @@
+#include "audio.h"
+#include "hardware/clocks.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/pwm.h"
+#include "hardware/sync.h"
+
+#define AUDIO_WAVE_SIZE (1u << AUDIO_WAVE_BITS)
+// Blocos de silêncio antes de desligar a saída
+#define AUDIO_IDLE_BLOCKS 2
+
+static const int8_t audio_wave_square[AUDIO_WAVE_SIZE] = {
+     127,  127,  127,  127,  127,  127,  127,  127,  127,  127,  127,  127,  127,  127,  127,  127,
+    -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127
+};
+
+static const int8_t audio_wave_triangle[AUDIO_WAVE_SIZE] = {
+       0,   16,   32,   48,   64,   79,   95,  111,  127,  111,   95,   79,   64,   48,   32,   16,
+       0,  -16,  -32,  -48,  -64,  -79,  -95, -111, -127, -111,  -95,  -79,  -64,  -48,  -32,  -16
+};
+
+// Incremento de fase das notas MIDI 120..131 (C9..B9); as oitavas abaixo
+// saem por deslocamento.
+#define AUDIO_NOTE_PHASE(hz) ((uint32_t)((hz) * 4294967296.0 / AUDIO_SAMPLE_RATE + 0.5))
+#define AUDIO_TOP_OCTAVE 10
+
+static const uint32_t audio_top_octave[12] = {
+    AUDIO_NOTE_PHASE(8372.02),  AUDIO_NOTE_PHASE(8869.84),  AUDIO_NOTE_PHASE(9397.27),
+    AUDIO_NOTE_PHASE(9956.06),  AUDIO_NOTE_PHASE(10548.08), AUDIO_NOTE_PHASE(11175.30),
+    AUDIO_NOTE_PHASE(11839.82), AUDIO_NOTE_PHASE(12543.85), AUDIO_NOTE_PHASE(13289.75),
+    AUDIO_NOTE_PHASE(14080.00), AUDIO_NOTE_PHASE(14917.24), AUDIO_NOTE_PHASE(15804.27)
+};
+
+typedef struct {
+    const uint8_t *code;     // Início do bytecode
+    const uint8_t *pc;       // Próximo byte a decodificar
+    const uint8_t *mark;     // Ponto de retorno do LOOP (NULL = início)
+    uint32_t whole_samples;  // Duração de uma semibreve no andamento atual
+    uint8_t base;            // Nota MIDI do índice 1
+    const int8_t *wave;
+    uint8_t volume;
+    uint32_t phase;
+    uint32_t phase_inc;      // 0 = pausa
+    uint32_t samples_left;   // Amostras restantes da nota atual
+    volatile bool active;
+} audio_voice_t;
+
+static audio_voice_t audio_voices[AUDIO_VOICES];
+
+// Dois buffers em ping-pong, um por canal de DMA. Escritas de 16 bits no
+// registrador CC são replicadas nas duas metades, então os canais A e B do
+// slice recebem a mesma amostra.
+static uint16_t audio_buffers[2][AUDIO_BLOCK_SAMPLES];
+static int audio_dma_chan[2];
+static int audio_dma_timer;
+static uint audio_slice;
+
+static volatile bool audio_running = false;
+static uint8_t audio_idle_blocks = 0;
+static uint32_t audio_blocks = 0;
+static uint32_t audio_max_mix_us = 0;
+
+static inline uint32_t audio_midi_phase_inc(uint note) {
+    if (note > 127)
+        return 0;
+    return audio_top_octave[note % 12] >> (AUDIO_TOP_OCTAVE - note / 12);
+}
+
+// Decodifica o bytecode até a próxima nota; retorna false quando a melodia
+// terminou (END, opcode inválido ou LOOP sem nenhuma nota no caminho).
+static bool audio_next_note(audio_voice_t *voice) {
+    bool dotted = false;
+    bool looped = false;
+    for (;;) {
+        uint8_t op = *voice->pc++;
+        if (op < AUDIO_OP_END) {
+            uint32_t samples = voice->whole_samples >> (op >> 5);
+            if (dotted)
+                samples += samples >> 1;
+            uint index = op & 0x1F;
+            voice->samples_left = samples ? samples : 1;
+            voice->phase_inc = index ? audio_midi_phase_inc(voice->base + index - 1) : 0;
+            return true;
+        }
+        switch (op) {
+        case AUDIO_OP_LOOP:
+            if (looped)
+                break;
+            looped = true;
+            voice->pc = voice->mark ? voice->mark : voice->code;
+            continue;
+        case AUDIO_OP_MARK:
+            voice->mark = voice->pc;
+            continue;
+        case AUDIO_OP_DOT:
+            dotted = true;
+            continue;
+        case AUDIO_OP_TEMPO: {
+            uint32_t bpm = ((uint32_t)voice->pc[0] << 8) | voice->pc[1];
+            voice->pc += 2;
+            // Semibreve = 4 batidas
+            voice->whole_samples = bpm ? (4u * 60u * AUDIO_SAMPLE_RATE) / bpm : 0;
+            continue;
+        }
+        case AUDIO_OP_BASE:
+            voice->base = *voice->pc++;
+            continue;
+        default:
+            break;
+        }
+        voice->active = false;
+        return false;
+    }
+}
+
+// Mistura as vozes ativas em amostras de 8 bits centradas em 128.
+static void audio_mix(uint16_t *out, uint n) {
+    bool any = false;
+    for (uint i = 0; i < n; i++) {
+        int32_t acc = 0;
+        for (int v = 0; v < AUDIO_VOICES; v++) {
+            audio_voice_t *voice = &audio_voices[v];
+            if (!voice->active)
+                continue;
+            while (voice->samples_left == 0) {
+                if (!audio_next_note(voice))
+                    break;
+            }
+            if (!voice->active)
+                continue;
+            any = true;
+            voice->samples_left--;
+            if (voice->phase_inc) {
+                voice->phase += voice->phase_inc;
+                acc += voice->wave[voice->phase >> (32 - AUDIO_WAVE_BITS)] * voice->volume;
+            }
+        }
+        int32_t sample = 128 + (acc >> 8);
+        if (sample < 0)
+            sample = 0;
+        else if (sample > AUDIO_PWM_WRAP)
+            sample = AUDIO_PWM_WRAP;
+        out[i] = (uint16_t)sample;
+    }
+    audio_idle_blocks = any ? 0 : audio_idle_blocks + 1;
+}
+
+// Taxa de amostragem = clk_sys / den
+static void audio_set_rate(void) {
+    uint32_t den = clock_get_hz(clk_sys) / AUDIO_SAMPLE_RATE;
+    dma_timer_set_fraction(audio_dma_timer, 1, (uint16_t)den);
+}
+
+static void audio_output_start(void) {
+    // O divisor do timer é recalculado aqui, já que o clk_sys pode ter mudado
+    gpio_set_function(AUDIO_PIN, GPIO_FUNC_PWM);
+    pwm_set_enabled(audio_slice, true);
+    audio_set_rate();
+    audio_running = true;
+}
+
+// Chamado com a DMA parada pelo timer: nenhuma transferência em andamento
+// avança enquanto a fração for 0/0.
+static void audio_output_stop(void) {
+    dma_timer_set_fraction(audio_dma_timer, 0, 0);
+    pwm_set_enabled(audio_slice, false);
+    gpio_set_function(AUDIO_PIN, GPIO_FUNC_SIO);
+    gpio_put(AUDIO_PIN, 0);
+    audio_running = false;
+}
+
+static void audio_dma_irq_handler(void) {
+    for (int i = 0; i < 2; i++) {
+        uint ch = (uint)audio_dma_chan[i];
+        if (!dma_channel_get_irq0_status(ch))
+            continue;
+        dma_channel_acknowledge_irq0(ch);
+        // Este canal terminou e o outro (encadeado) já está tocando: reabastece
+        uint32_t start = time_us_32();
+        dma_channel_set_read_addr(ch, audio_buffers[i], false);
+        audio_mix(audio_buffers[i], AUDIO_BLOCK_SAMPLES);
+        uint32_t elapsed = time_us_32() - start;
+        if (elapsed > audio_max_mix_us)
+            audio_max_mix_us = elapsed;
+        audio_blocks++;
+    }
+    if (audio_running && audio_idle_blocks >= AUDIO_IDLE_BLOCKS)
+        audio_output_stop();
+}
+
+void audio_init(void) {
+    gpio_init(AUDIO_PIN);
+    gpio_set_dir(AUDIO_PIN, GPIO_OUT);
+    gpio_put(AUDIO_PIN, 0);
+
+    audio_slice = pwm_gpio_to_slice_num(AUDIO_PIN);
+    pwm_set_clkdiv(audio_slice, 1.0f);
+    pwm_set_wrap(audio_slice, AUDIO_PWM_WRAP);
+    pwm_set_chan_level(audio_slice, pwm_gpio_to_channel(AUDIO_PIN), AUDIO_PWM_WRAP / 2);
+
+    for (uint i = 0; i < AUDIO_BLOCK_SAMPLES; i++) {
+        audio_buffers[0][i] = 128;
+        audio_buffers[1][i] = 128;
+    }
+
+    audio_dma_timer = dma_claim_unused_timer(true);
+    dma_timer_set_fraction(audio_dma_timer, 0, 0);
+    audio_dma_chan[0] = dma_claim_unused_channel(true);
+    audio_dma_chan[1] = dma_claim_unused_channel(true);
+
+    // Cada canal toca um buffer e dispara o outro ao terminar
+    for (int i = 0; i < 2; i++) {
+        dma_channel_config cfg = dma_channel_get_default_config(audio_dma_chan[i]);
+        channel_config_set_transfer_data_size(&cfg, DMA_SIZE_16);
+        channel_config_set_read_increment(&cfg, true);
+        channel_config_set_write_increment(&cfg, false);
+        channel_config_set_dreq(&cfg, dma_get_timer_dreq(audio_dma_timer));
+        channel_config_set_chain_to(&cfg, audio_dma_chan[1 - i]);
+        dma_channel_configure(audio_dma_chan[i], &cfg, &pwm_hw->slice[audio_slice].cc,
+                              audio_buffers[i], AUDIO_BLOCK_SAMPLES, false);
+        dma_channel_set_irq0_enabled(audio_dma_chan[i], true);
+    }
+    irq_add_shared_handler(DMA_IRQ_0, audio_dma_irq_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_0, true);
+
+    // O canal fica armado esperando o timer, que só anda com a saída ligada
+    dma_channel_start(audio_dma_chan[0]);
+}
+
+void audio_play(audio_voice_id_t voice_id, const uint8_t *melody, audio_wave_t wave, uint8_t volume) {
+    audio_voice_t *voice = &audio_voices[voice_id];
+    uint32_t irq = save_and_disable_interrupts();
+    voice->code = melody;
+    voice->pc = melody;
+    voice->mark = NULL;
+    voice->whole_samples = 0;
+    voice->base = 60;
+    voice->wave = (wave == AUDIO_WAVE_TRIANGLE) ? audio_wave_triangle : audio_wave_square;
+    voice->volume = volume;
+    voice->phase = 0;
+    voice->samples_left = 0;
+    voice->active = true;
+    audio_idle_blocks = 0;
+    if (!audio_running)
+        audio_output_start();
+    restore_interrupts(irq);
+}
+
+void audio_stop(audio_voice_id_t voice_id) {
+    audio_voices[voice_id].active = false;
+}
+
+bool audio_is_playing(audio_voice_id_t voice_id) {
+    return audio_voices[voice_id].active;
+}
+
+void audio_retime(void) {
+    uint32_t irq = save_and_disable_interrupts();
+    if (audio_running)
+        audio_set_rate();
+    restore_interrupts(irq);
+}
+
+void audio_get_stats(uint32_t *blocks, uint32_t *max_mix_us) {
+    *blocks = audio_blocks;
+    *max_mix_us = audio_max_mix_us;
+}
@@ -0,0 +1,61 @@
+#ifndef AUDIO_H
+#define AUDIO_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "pico/stdlib.h"
+
+// Motor de áudio: vozes de tabela de onda misturadas em ponto fixo e entregues
+// por DMA a um slice de PWM, a uma taxa de amostragem fixa. A CPU só trabalha
+// uma vez por bloco (na interrupção da DMA), para preencher o próximo bloco.
+
+#ifndef AUDIO_PIN
+#define AUDIO_PIN 10            // Buzzer da música de fundo (BUZZER_BG)
+#endif
+
+#define AUDIO_SAMPLE_RATE 16000
+#define AUDIO_BLOCK_SAMPLES 128  // 8 ms por bloco (dois blocos em ping-pong)
+#define AUDIO_PWM_WRAP 255       // Amostras de 8 bits; portadora de clk_sys / 256
+#define AUDIO_WAVE_BITS 5        // Tabelas de onda com 32 pontos
+
+// Bytecode das melodias (gerado de assets/sounds por tools/rtttl_compile.py):
+//   0x00-0xBF: nota = (classe de duração << 5) | índice; classe 0..5 = 1/1..1/32,
+//              índice 0 = pausa, 1..31 = semitons acima da base
+//   0xC0 END, 0xC1 LOOP, 0xC2 MARK, 0xC3 DOT, 0xC4 hi lo TEMPO (bpm), 0xC5 n BASE (MIDI)
+#define AUDIO_OP_END 0xC0
+#define AUDIO_OP_LOOP 0xC1
+#define AUDIO_OP_MARK 0xC2
+#define AUDIO_OP_DOT 0xC3
+#define AUDIO_OP_TEMPO 0xC4
+#define AUDIO_OP_BASE 0xC5
+
+typedef enum {
+    AUDIO_VOICE_MUSIC = 0,  // Música de fundo (normalmente em loop)
+    AUDIO_VOICE_FX,         // Efeitos tocados por cima da música
+    AUDIO_VOICES
+} audio_voice_id_t;
+
+typedef enum {
+    AUDIO_WAVE_SQUARE = 0,
+    AUDIO_WAVE_TRIANGLE,
+} audio_wave_t;
+
+// Reserva os canais de DMA e o timer de DMA e configura o PWM. A saída só
+// fica ligada enquanto alguma voz estiver tocando.
+void audio_init(void);
+
+// Começa a tocar a melodia na voz indicada e retorna imediatamente. O bytecode
+// é lido direto da flash, uma nota por vez, enquanto a voz toca.
+void audio_play(audio_voice_id_t voice, const uint8_t *melody, audio_wave_t wave, uint8_t volume);
+
+void audio_stop(audio_voice_id_t voice);
+bool audio_is_playing(audio_voice_id_t voice);
+
+// Recalcula o ritmo da DMA após uma troca do clk_sys (chamada pela gerência de energia)
+void audio_retime(void);
+
+// Blocos misturados e o pior tempo de mistura de um bloco (em µs)
+void audio_get_stats(uint32_t *blocks, uint32_t *max_mix_us);
+
+#endif // AUDIO_H
@@ -0,0 +1,65 @@
+#include "boot.h"
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "pico/stdio_usb.h"
+#include "tusb.h"
+#include "logger.h"
+
+static const char *const boot_phase_names[BOOT_PHASE_COUNT] = {
+    "clock", "stdio", "config", "display", "perifericos", "jogo", "primeira tela", "usb"
+};
+
+static uint32_t boot_end_us[BOOT_PHASE_COUNT];
+
+void boot_mark(boot_phase_t phase) {
+    if (phase >= BOOT_PHASE_COUNT || boot_end_us[phase])
+        return;
+    boot_end_us[phase] = time_us_32();
+    if (phase == BOOT_PHASE_FIRST_FRAME)
+        LOG_INFO("boot: primeira tela em %lu ms (display %lu ms)\n",
+                 boot_end_us[phase] / 1000,
+                 (boot_end_us[BOOT_PHASE_DISPLAY] - boot_end_us[BOOT_PHASE_CONFIG]) / 1000);
+}
+
+// A enumeração do USB roda por interrupção enquanto o jogo já roda; aqui só se
+// confere o estado a cada volta do laço. O tud_connected() só fica verdadeiro
+// no primeiro SETUP do host; sem host (bateria, carregador) ele nunca chega e
+// a espera acaba no prazo de detecção.
+bool boot_usb_poll(void) {
+    static bool done = false;
+    static uint32_t host_us = 0;     // Quando o host apareceu (0 = ainda não)
+    if (done)
+        return false;
+
+    uint32_t now = time_us_32();
+    if (!host_us && tud_connected())
+        host_us = now ? now : 1;
+    if (stdio_usb_connected())
+        LOG_INFO("boot: terminal USB aberto em %lu ms\n", now / 1000);
+    else if (host_us ? now - host_us < BOOT_USB_WAIT_MS * 1000u : now < BOOT_USB_DETECT_MS * 1000u)
+        return true;
+    done = true;
+    boot_mark(BOOT_PHASE_USB);
+    return false;
+}
+
+uint32_t boot_phase_end_us(boot_phase_t phase) {
+    return phase < BOOT_PHASE_COUNT ? boot_end_us[phase] : 0;
+}
+
+const char *boot_phase_name(uint8_t phase) {
+    return phase < BOOT_PHASE_COUNT ? boot_phase_names[phase] : "?";
+}
+
+void boot_print(void) {
+    uint32_t start = 0;
+    for (uint8_t i = 0; i < BOOT_PHASE_COUNT; i++) {
+        if (!boot_end_us[i]) {
+            printf("%-14s -\n", boot_phase_names[i]);
+            continue;
+        }
+        printf("%-14s %7lu us  (fim em %lu us)\n", boot_phase_names[i],
+               (unsigned long)(boot_end_us[i] - start), (unsigned long)boot_end_us[i]);
+        start = boot_end_us[i];
+    }
+}
@@ -0,0 +1,50 @@
+#ifndef BOOT_H
+#define BOOT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Perfil do boot: o fim de cada fase é marcado com time_us_32(), que conta
+// desde o reset, então os tempos incluem o bootrom e a inicialização do SDK.
+// O resumo vai para o log quando a primeira tela do jogo é enviada e pode ser
+// consultado depois pelo comando "boot" do console.
+
+// Espera pelo USB, sem bloquear o jogo: enquanto um host pode estar
+// enumerando a placa, o log do boot fica retido para o terminal que vai abrir.
+// O host só manda o primeiro SETUP depois do debounce da conexão (>= 100 ms) e
+// do reset do barramento, em geral 150-300 ms após o pull-up; o prazo cobre isso.
+// (O VBUS do controlador não serve: o TinyUSB força a detecção no RP2040 e a
+// Pico W só vê o VBUS pelo chip Wi-Fi.)
+#ifndef BOOT_USB_DETECT_MS
+#define BOOT_USB_DETECT_MS 500      // Prazo (desde o reset) para o host aparecer
+#endif
+#define BOOT_USB_WAIT_MS 1500       // Prazo para abrir o terminal, desde que o host apareceu
+
+typedef enum {
+    BOOT_PHASE_CLOCK = 0,       // Clock do sistema ajustado (uma vez só)
+    BOOT_PHASE_STDIO,           // UART e USB CDC
+    BOOT_PHASE_CONFIG,          // Recordes e parâmetros da flash
+    BOOT_PHASE_DISPLAY,         // I2C e sequência de inicialização do OLED
+    BOOT_PHASE_PERIPHERALS,     // Joystick, matriz, efeitos, energia, áudio, telemetria
+    BOOT_PHASE_GAME,            // Jogo iniciado ou restaurado do retrato
+    BOOT_PHASE_FIRST_FRAME,     // Primeira tela enviada ao OLED
+    BOOT_PHASE_USB,             // Terminal aberto ou fim da espera (já com o jogo rodando)
+    BOOT_PHASE_COUNT
+} boot_phase_t;
+
+// Marca o fim de uma fase. Só a primeira marca de cada fase vale.
+void boot_mark(boot_phase_t phase);
+
+// Acompanha a espera pelo terminal USB; chamado no tempo ocioso do laço.
+// Retorna true enquanto ela durar (o log deve continuar retido).
+bool boot_usb_poll(void);
+
+// Instante (us desde o reset) do fim da fase; 0 se ainda não aconteceu
+uint32_t boot_phase_end_us(boot_phase_t phase);
+
+const char *boot_phase_name(uint8_t phase);
+
+// Tabela de fases com duração e instante (console)
+void boot_print(void);
+
+#endif // BOOT_H
@@ -0,0 +1,148 @@
+#include "config.h"
+#include <stddef.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "pico/flash.h"
+#include "hardware/flash.h"
+#include "snake.h"
+#include "power.h"
+#include "logger.h"
+
+// Último setor da flash, longe do programa
+#define CONFIG_FLASH_OFFSET (PICO_FLASH_SIZE_BYTES - FLASH_SECTOR_SIZE)
+#define CONFIG_FLASH_TIMEOUT_MS 100
+
+// Cópia gravada: cabeçalho + config_t + soma de verificação, numa página
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t size;
+    config_t values;
+    uint32_t checksum;
+} config_record_t;
+
+_Static_assert(sizeof(config_record_t) <= FLASH_PAGE_SIZE, "config_record_t precisa caber numa página");
+
+config_t config;
+
+static const config_t config_default_values = {
+    .frame_delay_ms = FRAME_DELAY,
+    .dead_zone = DEAD_ZONE,
+    .num_samples = NUM_SAMPLES,
+    .led_brightness = 255,
+    .render_fps = RENDER_FPS,
+    .i2c_hz = OLED_I2C_BAUDRATE,
+};
+
+static const config_param_t config_params[] = {
+    {"frame_delay", CONFIG_U16, offsetof(config_t, frame_delay_ms), 20, 2000, NULL,
+     "periodo do quadro (ms)"},
+    {"dead_zone", CONFIG_U16, offsetof(config_t, dead_zone), 0, 2000, NULL,
+     "zona morta do joystick (ADC)"},
+    {"num_samples", CONFIG_U8, offsetof(config_t, num_samples), 1, 32, NULL,
+     "leituras do ADC por amostra"},
+    {"led_brightness", CONFIG_U8, offsetof(config_t, led_brightness), 0, 255, NULL,
+     "brilho do LED azul e da matriz (0-255)"},
+    {"render_fps", CONFIG_U16, offsetof(config_t, render_fps), 0, 60, NULL,
+     "telas por segundo entre ticks (0 = so nos ticks)"},
+    {"i2c_hz", CONFIG_U32, offsetof(config_t, i2c_hz), 10000, 1000000, power_set_i2c_baudrate,
+     "clock do I2C do OLED (Hz)"},
+};
+
+#define CONFIG_PARAM_COUNT (sizeof(config_params) / sizeof(config_params[0]))
+
+// FNV-1a de 32 bits
+static uint32_t config_checksum(const uint8_t *data, size_t len) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < len; i++) {
+        hash ^= data[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+void config_init(void) {
+    // Leitura direta pela XIP
+    const config_record_t *saved = (const config_record_t *)(XIP_BASE + CONFIG_FLASH_OFFSET);
+    if (saved->magic == CONFIG_MAGIC && saved->version == CONFIG_VERSION &&
+        saved->size == sizeof(config_t) &&
+        saved->checksum == config_checksum((const uint8_t *)&saved->values, sizeof(config_t))) {
+        config = saved->values;
+        LOG_INFO("config: carregada da flash\n");
+    } else {
+        config = config_default_values;
+    }
+}
+
+uint8_t config_count(void) {
+    return CONFIG_PARAM_COUNT;
+}
+
+const config_param_t *config_param(uint8_t index) {
+    return index < CONFIG_PARAM_COUNT ? &config_params[index] : NULL;
+}
+
+const config_param_t *config_find(const char *name) {
+    for (uint8_t i = 0; i < CONFIG_PARAM_COUNT; i++) {
+        if (strcmp(config_params[i].name, name) == 0)
+            return &config_params[i];
+    }
+    return NULL;
+}
+
+static uint32_t config_read(const config_t *values, const config_param_t *param) {
+    const uint8_t *field = (const uint8_t *)values + param->offset;
+    switch (param->type) {
+    case CONFIG_U8:  return *field;
+    case CONFIG_U16: return *(const uint16_t *)field;
+    default:         return *(const uint32_t *)field;
+    }
+}
+
+uint32_t config_get(const config_param_t *param) {
+    return config_read(&config, param);
+}
+
+bool config_set(const config_param_t *param, uint32_t value) {
+    if (value < param->min || value > param->max)
+        return false;
+    uint8_t *field = (uint8_t *)&config + param->offset;
+    switch (param->type) {
+    case CONFIG_U8:  *field = (uint8_t)value; break;
+    case CONFIG_U16: *(uint16_t *)field = (uint16_t)value; break;
+    default:         *(uint32_t *)field = value; break;
+    }
+    if (param->apply)
+        param->apply(value);
+    return true;
+}
+
+void config_defaults(void) {
+    for (uint8_t i = 0; i < CONFIG_PARAM_COUNT; i++)
+        config_set(&config_params[i], config_read(&config_default_values, &config_params[i]));
+}
+
+// Roda com as interrupções desligadas (e o outro núcleo parado) por flash_safe_execute
+static void config_flash_write(void *param) {
+    flash_range_erase(CONFIG_FLASH_OFFSET, FLASH_SECTOR_SIZE);
+    flash_range_program(CONFIG_FLASH_OFFSET, (const uint8_t *)param, FLASH_PAGE_SIZE);
+}
+
+bool config_save(void) {
+    static uint8_t page[FLASH_PAGE_SIZE];
+    config_record_t record = {
+        .magic = CONFIG_MAGIC,
+        .version = CONFIG_VERSION,
+        .size = sizeof(config_t),
+        .values = config,
+        .checksum = config_checksum((const uint8_t *)&config, sizeof(config_t)),
+    };
+    memset(page, 0xFF, sizeof(page));
+    memcpy(page, &record, sizeof(record));
+    int rc = flash_safe_execute(config_flash_write, page, CONFIG_FLASH_TIMEOUT_MS);
+    if (rc != PICO_OK) {
+        LOG_ERROR("config: falha ao gravar na flash (%d)\n", rc);
+        return false;
+    }
+    return true;
+}
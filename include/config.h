@@ -0,0 +1,67 @@
+#ifndef CONFIG_H
+#define CONFIG_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Parâmetros ajustáveis em tempo de execução (console pela serial), com valores
+// padrão vindos dos #defines de sempre. Os módulos leem direto de 'config';
+// os que precisam reconfigurar hardware recebem a mudança por um callback.
+// A cópia salva fica no último setor da flash.
+
+#define CONFIG_MAGIC 0x534E4B43u    // "SNKC"
+#define CONFIG_VERSION 2           // 2: render_fps e I2C a 400 kHz
+
+// Fast mode: a tela inteira leva ~23 ms; os quadros interpolados mandam
+// só as colunas que mudaram
+#ifndef OLED_I2C_BAUDRATE
+#define OLED_I2C_BAUDRATE (400 * 1000)
+#endif
+
+typedef struct {
+    uint16_t frame_delay_ms;   // Período do quadro (FRAME_DELAY)
+    uint16_t dead_zone;        // Zona morta do joystick (DEAD_ZONE)
+    uint8_t num_samples;       // Leituras do ADC por amostra (NUM_SAMPLES)
+    uint8_t led_brightness;    // Escala do LED azul e da matriz (255 = cheio)
+    uint16_t render_fps;       // Telas por segundo entre ticks (RENDER_FPS)
+    uint32_t i2c_hz;           // Clock do I2C do OLED
+} config_t;
+
+extern config_t config;
+
+typedef enum {
+    CONFIG_U8 = 0,
+    CONFIG_U16,
+    CONFIG_U32,
+} config_type_t;
+
+// Entrada do registro de parâmetros
+typedef struct {
+    const char *name;
+    uint8_t type;              // config_type_t
+    uint8_t offset;            // offsetof(config_t, campo)
+    uint32_t min;
+    uint32_t max;
+    void (*apply)(uint32_t value);  // NULL: o módulo lê o valor a cada uso
+    const char *help;
+} config_param_t;
+
+// Carrega a cópia da flash (ou os padrões, se não houver uma válida).
+// Chamar antes de inicializar os periféricos que usam os valores.
+void config_init(void);
+
+uint8_t config_count(void);
+const config_param_t *config_param(uint8_t index);
+const config_param_t *config_find(const char *name);
+
+uint32_t config_get(const config_param_t *param);
+// Valida a faixa, grava e aplica. Retorna false fora da faixa.
+bool config_set(const config_param_t *param, uint32_t value);
+
+// Volta aos padrões (e aplica); a flash só muda com config_save.
+void config_defaults(void);
+
+// Grava no último setor da flash. Bloqueia o núcleo por algumas dezenas de ms.
+bool config_save(void);
+
+#endif // CONFIG_H
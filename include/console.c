@@ -0,0 +1,217 @@
+#include "console.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "config.h"
+#include "deadline.h"
+#include "input.h"
+#include "power.h"
+#include "audio.h"
+#include "logger.h"
+#include "telemetry.h"
+#include "fbstream.h"
+#include "snapshot.h"
+#include "boot.h"
+#include "remote.h"
+#include "ui.h"
+#include "profiler.h"
+
+static char console_line[CONSOLE_LINE_MAX + 1];
+static uint8_t console_len = 0;
+static bool console_ready = false;      // Linha completa esperando o tempo ocioso
+static bool console_overflow = false;
+
+void console_feed(char ch) {
+    if (console_ready)
+        return;  // A linha anterior ainda não foi executada; descarta
+    if (ch == '\r' || ch == '\n') {
+        if (console_len > 0 || console_overflow)
+            console_ready = true;
+        return;
+    }
+    if (ch == '\b' || ch == 0x7F) {
+        if (console_len > 0)
+            console_len--;
+        return;
+    }
+    if (console_len < CONSOLE_LINE_MAX)
+        console_line[console_len++] = ch;
+    else
+        console_overflow = true;
+}
+
+bool console_line_empty(void) {
+    return console_len == 0 && !console_overflow;
+}
+
+// Valor inteiro em decimal ou hexadecimal (0x...); false se houver lixo
+static bool console_parse_u32(const char *text, uint32_t *value) {
+    char *end;
+    unsigned long v = strtoul(text, &end, 0);
+    if (end == text || *end != '\0')
+        return false;
+    *value = (uint32_t)v;
+    return true;
+}
+
+static void console_print_param(const config_param_t *param) {
+    printf("%-15s = %-8lu [%lu..%lu] %s\n", param->name, (unsigned long)config_get(param),
+           (unsigned long)param->min, (unsigned long)param->max, param->help);
+}
+
+static void console_cmd_help(void) {
+    printf("comandos: help, params, get <nome>, set <nome> <valor>, save, defaults, stats, boot, prof [hz]\n");
+}
+
+static void console_cmd_params(void) {
+    for (uint8_t i = 0; i < config_count(); i++)
+        console_print_param(config_param(i));
+}
+
+static void console_cmd_get(const char *name) {
+    const config_param_t *param = config_find(name);
+    if (!param) {
+        printf("parametro desconhecido: %s\n", name);
+        return;
+    }
+    console_print_param(param);
+}
+
+static void console_cmd_set(const char *name, const char *text) {
+    const config_param_t *param = config_find(name);
+    uint32_t value;
+    if (!param) {
+        printf("parametro desconhecido: %s\n", name);
+    } else if (!console_parse_u32(text, &value)) {
+        printf("valor invalido: %s\n", text);
+    } else if (!config_set(param, value)) {
+        printf("fora da faixa [%lu..%lu]\n", (unsigned long)param->min, (unsigned long)param->max);
+    } else {
+        console_print_param(param);
+    }
+}
+
+static void console_cmd_stats(void) {
+    const deadline_stats_t *dl = deadline_get_stats();
+    printf("quadros %lu  estouros %lu  pior %lu us (%s)\n", (unsigned long)dl->frames,
+           (unsigned long)dl->overruns, (unsigned long)dl->worst_late_us,
+           deadline_stage_name(dl->worst_stage));
+    if (dl->watchdog_reset)
+        printf("boot apos reset do watchdog em '%s' (quadro %lu)\n",
+               deadline_stage_name(dl->reset_stage), (unsigned long)dl->reset_frame);
+
+    input_stats_t in;
+    input_get_stats(&in);
+    printf("curvas %lu (rejeitadas %lu, perdidas %lu)  latencia %lu us (max %lu)\n",
+           (unsigned long)in.turns_queued, (unsigned long)in.turns_rejected,
+           (unsigned long)in.turns_dropped, (unsigned long)in.last_latency_us,
+           (unsigned long)in.max_latency_us);
+
+    remote_stats_t rm;
+    remote_get_stats(&rm);
+    if (rm.packets || rm.bad_crc)
+        printf("remoto: %lu pacotes (%lu invalidos)  latencia %lu us (max %lu)\n",
+               (unsigned long)rm.packets, (unsigned long)rm.bad_crc,
+               (unsigned long)rm.last_latency_us, (unsigned long)rm.max_latency_us);
+
+    ui_render_stats_t rs;
+    ui_get_render_stats(&rs);
+    printf("tela: %u fps (max %u)  desenho %lu us (max %lu)  i2c %lu bytes/s\n",
+           rs.fps, config.render_fps, (unsigned long)rs.last_draw_us,
+           (unsigned long)rs.max_draw_us, (unsigned long)rs.i2c_bytes_per_s);
+
+    uint32_t blocks, mix_us;
+    audio_get_stats(&blocks, &mix_us);
+    printf("audio: %lu blocos, mistura max %lu us\n", (unsigned long)blocks, (unsigned long)mix_us);
+
+    uint32_t captured, skipped;
+    fbstream_get_stats(&captured, &skipped);
+    printf("descartes: log %lu  telemetria %lu  telas %lu/%lu\n",
+           (unsigned long)logger_get_dropped(), (unsigned long)telemetry_get_dropped(),
+           (unsigned long)skipped, (unsigned long)captured);
+
+    const snapshot_stats_t *snap = snapshot_get_stats();
+    printf("retrato: %lu bytes, gravado %lu vezes (%lu us, serializacao %lu us), restaurado em %lu us\n",
+           (unsigned long)snap->bytes, (unsigned long)snap->saves, (unsigned long)snap->save_us,
+           (unsigned long)snap->encode_us, (unsigned long)snap->restore_us);
+
+    power_print_stats();
+}
+
+// Sem argumento, só mostra o estado; 'prof 0' para a amostragem
+static void console_cmd_prof(const char *text) {
+    uint32_t hz;
+    if (text) {
+        if (!console_parse_u32(text, &hz)) {
+            printf("valor invalido: %s\n", text);
+            return;
+        }
+        if (!PROFILER_ENABLED) {
+            printf("perfilador fora do build (-DSNAKE_PROFILER=ON)\n");
+            return;
+        }
+        if (!profiler_start(hz)) {
+            printf("taxa fora da faixa [0..%u] ou sem alarme livre\n", PROFILER_MAX_HZ);
+            return;
+        }
+    }
+    profiler_stats_t ps;
+    profiler_get_stats(&ps);
+    printf("perfil: %u Hz, %lu amostras (%lu enviadas, %lu perdidas com o buffer cheio)\n",
+           ps.hz, (unsigned long)ps.samples, (unsigned long)ps.sent, (unsigned long)ps.dropped);
+}
+
+// Separa a linha em palavras, no próprio buffer
+static uint8_t console_split(char *line, char **argv) {
+    uint8_t argc = 0;
+    char *p = line;
+    while (*p && argc < CONSOLE_MAX_ARGS) {
+        while (*p == ' ' || *p == '\t')
+            *p++ = '\0';
+        if (!*p)
+            break;
+        argv[argc++] = p;
+        while (*p && *p != ' ' && *p != '\t')
+            p++;
+    }
+    return argc;
+}
+
+void console_poll(void) {
+    if (!console_ready)
+        return;
+
+    if (console_overflow) {
+        printf("linha longa demais (max %d)\n", CONSOLE_LINE_MAX);
+    } else {
+        console_line[console_len] = '\0';
+        char *argv[CONSOLE_MAX_ARGS];
+        uint8_t argc = console_split(console_line, argv);
+        const char *cmd = argc ? argv[0] : "";
+
+        if (argc == 1 && strcmp(cmd, "help") == 0)
+            console_cmd_help();
+        else if (argc == 1 && strcmp(cmd, "params") == 0)
+            console_cmd_params();
+        else if (argc == 2 && strcmp(cmd, "get") == 0)
+            console_cmd_get(argv[1]);
+        else if (argc == 3 && strcmp(cmd, "set") == 0)
+            console_cmd_set(argv[1], argv[2]);
+        else if (argc == 1 && strcmp(cmd, "save") == 0)
+            printf(config_save() ? "salvo na flash\n" : "falha ao salvar\n");
+        else if (argc == 1 && strcmp(cmd, "defaults") == 0)
+            config_defaults();
+        else if (argc == 1 && strcmp(cmd, "stats") == 0)
+            console_cmd_stats();
+        else if (argc == 1 && strcmp(cmd, "boot") == 0)
+            boot_print();
+        else if (argc <= 2 && strcmp(cmd, "prof") == 0)
+            console_cmd_prof(argc == 2 ? argv[1] : NULL);
+        else if (argc > 0)
+            printf("comando desconhecido (help lista os comandos)\n");
+    }
+
+    console_len = 0;
+    console_overflow = false;
+    console_ready = false;
+}
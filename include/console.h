@@ -0,0 +1,36 @@
+#ifndef CONSOLE_H
+#define CONSOLE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Console de ajustes pela serial/USB. Os caracteres chegam pela máquina de
+// estados (ui.c) e vão para um buffer de linha fixo; a linha completa é
+// interpretada no tempo ocioso do laço, sem alocação.
+//
+//   help                     lista os comandos
+//   params                   todos os parâmetros, com valor e faixa
+//   get <nome>               valor de um parâmetro
+//   set <nome> <valor>       altera (vale na hora; decimal ou 0x...)
+//   save                     grava os parâmetros na flash
+//   defaults                 volta aos padrões (sem gravar)
+//   stats                    estatísticas de tempo, entrada, energia, buffers e retrato
+//   boot                     duração de cada fase do boot
+//   prof [hz]                estado do perfilador; com hz, muda a taxa (0 = para)
+//
+// Durante o jogo, i/j/k/l no início de uma linha continuam controlando a
+// cobra 2, por isso nenhum comando começa com essas letras.
+
+#define CONSOLE_LINE_MAX 48
+#define CONSOLE_MAX_ARGS 3
+
+// Acrescenta um caractere à linha (chamado do laço principal).
+void console_feed(char ch);
+
+// Nenhum caractere da linha atual recebido ainda
+bool console_line_empty(void);
+
+// Executa a linha completa, se houver. Chamado no tempo ocioso.
+void console_poll(void);
+
+#endif // CONSOLE_H
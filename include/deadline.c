@@ -0,0 +1,105 @@
+#include "deadline.h"
+#include <string.h>
+#include "hardware/watchdog.h"
+#include "logger.h"
+#include "telemetry.h"
+
+static const char *const deadline_stage_names[DEADLINE_STAGE_COUNT] = {
+    "laco", "entrada", "atualizacao", "desenho", "audio", "ui", "ocioso", "sono"
+};
+
+static deadline_stats_t deadline_stats;
+static deadline_overrun_t deadline_log[DEADLINE_LOG_SIZE];
+
+static uint8_t deadline_current = DEADLINE_STAGE_LOOP;
+static uint32_t deadline_stage_start = 0;
+static uint32_t deadline_cycle_us[DEADLINE_STAGE_COUNT];  // Tempo de cada estágio desde o último quadro
+
+void deadline_init(void) {
+    memset(&deadline_stats, 0, sizeof(deadline_stats));
+    memset(deadline_cycle_us, 0, sizeof(deadline_cycle_us));
+
+    // Os registradores de rascunho mantêm o valor num reset do watchdog (não num power-on)
+    if (watchdog_enable_caused_reboot() && watchdog_hw->scratch[DEADLINE_SCRATCH_MAGIC] == DEADLINE_MAGIC) {
+        deadline_stats.watchdog_reset = true;
+        deadline_stats.reset_stage = (uint8_t)watchdog_hw->scratch[DEADLINE_SCRATCH_STAGE];
+        deadline_stats.reset_frame = watchdog_hw->scratch[DEADLINE_SCRATCH_FRAME];
+        LOG_ERROR("deadline: reset do watchdog em '%s' (quadro %lu)\n",
+                  deadline_stage_name(deadline_stats.reset_stage), deadline_stats.reset_frame);
+        uint8_t data[3] = {deadline_stats.reset_stage, deadline_stats.reset_frame & 0xFF,
+                           (deadline_stats.reset_frame >> 8) & 0xFF};
+        telemetry_event(TLM_EVENT_WATCHDOG, data, sizeof(data));
+    }
+
+    watchdog_hw->scratch[DEADLINE_SCRATCH_MAGIC] = DEADLINE_MAGIC;
+    watchdog_hw->scratch[DEADLINE_SCRATCH_FRAME] = 0;
+    deadline_stage(DEADLINE_STAGE_LOOP);
+    // Pausa no depurador para não resetar num breakpoint
+    watchdog_enable(DEADLINE_WATCHDOG_MS, true);
+}
+
+uint32_t deadline_stage(deadline_stage_t stage) {
+    uint32_t now = time_us_32();
+    deadline_cycle_us[deadline_current] += now - deadline_stage_start;
+    deadline_current = (uint8_t)stage;
+    deadline_stage_start = now;
+    watchdog_hw->scratch[DEADLINE_SCRATCH_STAGE] = stage;
+    return now;
+}
+
+void deadline_frame_end(absolute_time_t deadline) {
+    deadline_stats.frames++;
+    watchdog_hw->scratch[DEADLINE_SCRATCH_FRAME] = deadline_stats.frames;
+
+    int64_t late = absolute_time_diff_us(deadline, get_absolute_time());
+    if (late > 0) {
+        // Culpado: o estágio que mais tempo levou desde o quadro anterior
+        // (o sono e o topo do laço não contam)
+        uint8_t culprit = DEADLINE_STAGE_INPUT;
+        for (uint8_t s = DEADLINE_STAGE_INPUT; s < DEADLINE_STAGE_SLEEP; s++) {
+            if (deadline_cycle_us[s] > deadline_cycle_us[culprit])
+                culprit = s;
+        }
+        uint32_t late_us = late > UINT32_MAX ? UINT32_MAX : (uint32_t)late;
+
+        deadline_overrun_t *entry = &deadline_log[deadline_stats.overruns & (DEADLINE_LOG_SIZE - 1)];
+        entry->frame = deadline_stats.frames;
+        entry->stage = culprit;
+        entry->stage_us = deadline_cycle_us[culprit];
+        entry->late_us = late_us;
+        deadline_stats.overruns++;
+        if (late_us > deadline_stats.worst_late_us) {
+            deadline_stats.worst_late_us = late_us;
+            deadline_stats.worst_stage = culprit;
+        }
+
+        LOG_WARN("deadline: quadro %lu atrasou %lu us ('%s' levou %lu us)\n",
+                 entry->frame, late_us, deadline_stage_name(culprit), entry->stage_us);
+        uint8_t data[5] = {culprit, late_us & 0xFF, (late_us >> 8) & 0xFF,
+                           (late_us >> 16) & 0xFF, (late_us >> 24) & 0xFF};
+        telemetry_event(TLM_EVENT_OVERRUN, data, sizeof(data));
+    }
+    memset(deadline_cycle_us, 0, sizeof(deadline_cycle_us));
+}
+
+// Só o laço principal chega aqui; uma interrupção ou timer que continuasse
+// rodando com o laço travado nunca alimenta o watchdog.
+void deadline_loop_done(void) {
+    deadline_stage(DEADLINE_STAGE_LOOP);
+    watchdog_update();
+}
+
+const deadline_stats_t *deadline_get_stats(void) {
+    return &deadline_stats;
+}
+
+bool deadline_get_overrun(uint8_t i, deadline_overrun_t *out) {
+    if (i >= DEADLINE_LOG_SIZE || i >= deadline_stats.overruns)
+        return false;
+    *out = deadline_log[(deadline_stats.overruns - 1 - i) & (DEADLINE_LOG_SIZE - 1)];
+    return true;
+}
+
+const char *deadline_stage_name(uint8_t stage) {
+    return stage < DEADLINE_STAGE_COUNT ? deadline_stage_names[stage] : "?";
+}
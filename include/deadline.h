@@ -0,0 +1,75 @@
+#ifndef DEADLINE_H
+#define DEADLINE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pico/stdlib.h"
+
+// Monitor de prazos: o laço principal marca o estágio em andamento (gravado num
+// registrador de rascunho do watchdog, que sobrevive ao reset) e cada quadro do
+// jogo é comparado com o seu prazo. O watchdog só é alimentado quando o laço
+// completa uma volta; um travamento (barramento I2C preso, laço sem fim) causa
+// um reset, e o boot seguinte informa em que estágio o jogo estava.
+
+#define DEADLINE_WATCHDOG_MS 2000       // Bem acima de um quadro (FRAME_DELAY) e do sono máximo
+#define DEADLINE_LOG_SIZE 8             // Últimos estouros guardados (potência de 2)
+
+// Registradores de rascunho usados (o SDK reserva 4..7 para watchdog_reboot)
+#define DEADLINE_SCRATCH_MAGIC 0
+#define DEADLINE_SCRATCH_STAGE 1
+#define DEADLINE_SCRATCH_FRAME 2
+#define DEADLINE_MAGIC 0x534E4B45u      // "SNKE"
+
+// Estágios do laço; os quatro do quadro seguem a ordem de telemetry_stage_t
+typedef enum {
+    DEADLINE_STAGE_LOOP = 0,   // Topo do laço (nenhum trabalho em andamento)
+    DEADLINE_STAGE_INPUT,
+    DEADLINE_STAGE_UPDATE,
+    DEADLINE_STAGE_DRAW,
+    DEADLINE_STAGE_AUDIO,
+    DEADLINE_STAGE_UI,         // Eventos e telas da máquina de estados
+    DEADLINE_STAGE_IDLE,       // Tarefas ociosas (fbstream, telemetria, log)
+    DEADLINE_STAGE_SLEEP,
+    DEADLINE_STAGE_COUNT
+} deadline_stage_t;
+
+// Um estouro: quadro, estágio mais longo desde o quadro anterior e atraso
+typedef struct {
+    uint32_t frame;
+    uint8_t stage;
+    uint32_t stage_us;
+    uint32_t late_us;
+} deadline_overrun_t;
+
+typedef struct {
+    uint32_t frames;
+    uint32_t overruns;
+    uint32_t worst_late_us;
+    uint8_t worst_stage;
+    bool watchdog_reset;       // O boot atual veio de um reset do watchdog
+    uint8_t reset_stage;       // Estágio em andamento quando o watchdog disparou
+    uint32_t reset_frame;
+} deadline_stats_t;
+
+// Lê o que sobrou do boot anterior e liga o watchdog. Chamar por último na
+// inicialização, quando o laço principal já vai começar.
+void deadline_init(void);
+
+// Marca o início de um estágio (e o fim do anterior). Retorna time_us_32().
+uint32_t deadline_stage(deadline_stage_t stage);
+
+// Fim de um quadro que deveria terminar até 'deadline': registra o estouro,
+// com o estágio mais longo desde o último quadro e o atraso.
+void deadline_frame_end(absolute_time_t deadline);
+
+// Fim de uma volta do laço principal: alimenta o watchdog.
+void deadline_loop_done(void);
+
+const deadline_stats_t *deadline_get_stats(void);
+
+// Estouro i (0 = mais recente); false se não houver
+bool deadline_get_overrun(uint8_t i, deadline_overrun_t *out);
+
+const char *deadline_stage_name(uint8_t stage);
+
+#endif // DEADLINE_H
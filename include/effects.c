@@ -0,0 +1,235 @@
+#include "effects.h"
+#include <string.h>
+#include "hardware/pwm.h"
+#include "hardware/sync.h"
+#include "config.h"
+
+typedef enum {
+    EFFECT_KIND_NONE = 0,
+    EFFECT_KIND_LED,
+    EFFECT_KIND_MATRIX,
+} effect_kind_t;
+
+typedef struct {
+    effect_t id;
+    uint8_t kind;
+    uint8_t count;
+    uint8_t repeat;       // Repetições restantes (EFFECTS_FOREVER = sem fim)
+    uint8_t index;        // Quadro atual da matriz
+    uint32_t elapsed_ms;  // Tempo na repetição (LED) ou no quadro atual (matriz)
+    union {
+        const effect_key_t *keys;
+        const effect_frame_t *frames;
+    };
+} effect_slot_t;
+
+static effect_slot_t effects_slots[EFFECTS_MAX];
+static effect_t effects_next_id = 1;
+
+static pio_t *effects_matrix = NULL;
+static uint effects_led_gpio = 0;
+
+static repeating_timer_t effects_timer;
+static volatile bool effects_running = false;
+
+// Último estado enviado; só há escrita no hardware quando algo muda
+static int16_t effects_led_level = -1;
+static uint32_t effects_matrix_out[NUM_PIXELS];  // Lido pela DMA da matriz
+static bool effects_matrix_lit = false;
+static bool effects_matrix_dirty = false;
+
+void effects_init(pio_t *led_matrix, uint led_gpio) {
+    effects_matrix = led_matrix;
+    effects_led_gpio = led_gpio;
+    memset(effects_slots, 0, sizeof(effects_slots));
+}
+
+// Brilho do LED no instante t, interpolando entre os quadros-chave
+static uint8_t effects_led_at(const effect_slot_t *slot, uint32_t t) {
+    const effect_key_t *keys = slot->keys;
+    if (t <= keys[0].t_ms)
+        return keys[0].level;
+    for (uint8_t k = 1; k < slot->count; k++) {
+        if (t < keys[k].t_ms) {
+            int32_t span = keys[k].t_ms - keys[k - 1].t_ms;
+            int32_t delta = (int32_t)keys[k].level - keys[k - 1].level;
+            return (uint8_t)(keys[k - 1].level + delta * (int32_t)(t - keys[k - 1].t_ms) / span);
+        }
+    }
+    return keys[slot->count - 1].level;
+}
+
+// Fim de uma repetição: retorna false quando o efeito terminou
+static bool effects_next_repeat(effect_slot_t *slot) {
+    if (slot->repeat == 1) {
+        slot->kind = EFFECT_KIND_NONE;
+        return false;
+    }
+    if (slot->repeat != EFFECTS_FOREVER)
+        slot->repeat--;
+    return true;
+}
+
+// Escala pelo brilho global (config.led_brightness, ajustável pelo console)
+static inline uint8_t effects_dim(uint8_t level) {
+    return (uint8_t)(((uint32_t)level * config.led_brightness + 127) / 255);
+}
+
+// Mesmo formato de matrix_rgb (GRB nos três bytes altos), sem ponto flutuante
+static inline uint32_t effects_pixel(uint8_t p, const effect_frame_t *frame) {
+    p = effects_dim(p);
+    uint32_t r = ((uint32_t)p * frame->r + 255) >> 8;
+    uint32_t g = ((uint32_t)p * frame->g + 255) >> 8;
+    uint32_t b = ((uint32_t)p * frame->b + 255) >> 8;
+    return (g << 24) | (r << 16) | (b << 8);
+}
+
+// Composição pelo máximo de cada canal
+static inline uint32_t effects_max_grb(uint32_t a, uint32_t b) {
+    uint32_t out = 0;
+    for (uint shift = 8; shift <= 24; shift += 8) {
+        uint32_t ca = (a >> shift) & 0xFF;
+        uint32_t cb = (b >> shift) & 0xFF;
+        out |= (ca > cb ? ca : cb) << shift;
+    }
+    return out;
+}
+
+static bool effects_tick(repeating_timer_t *t) {
+    uint8_t led = 0;
+    uint32_t matrix[NUM_PIXELS] = {0};
+    bool active = false;
+
+    for (int s = 0; s < EFFECTS_MAX; s++) {
+        effect_slot_t *slot = &effects_slots[s];
+        if (slot->kind == EFFECT_KIND_LED) {
+            uint8_t level = effects_led_at(slot, slot->elapsed_ms);
+            if (level > led)
+                led = level;
+            slot->elapsed_ms += EFFECTS_TICK_MS;
+            if (slot->elapsed_ms > slot->keys[slot->count - 1].t_ms) {
+                slot->elapsed_ms = 0;
+                effects_next_repeat(slot);
+            }
+        } else if (slot->kind == EFFECT_KIND_MATRIX) {
+            const effect_frame_t *frame = &slot->frames[slot->index];
+            if (frame->pixels) {
+                for (int i = 0; i < NUM_PIXELS; i++) {
+                    // Mesma ordem de envio de desenho_pio (último pixel primeiro)
+                    uint8_t p = frame->pixels[NUM_PIXELS - 1 - i];
+                    if (p)
+                        matrix[i] = effects_max_grb(matrix[i], effects_pixel(p, frame));
+                }
+            }
+            slot->elapsed_ms += EFFECTS_TICK_MS;
+            if (slot->elapsed_ms >= frame->duration_ms) {
+                slot->elapsed_ms = 0;
+                if (++slot->index >= slot->count) {
+                    slot->index = 0;
+                    effects_next_repeat(slot);
+                }
+            }
+        }
+        if (slot->kind != EFFECT_KIND_NONE)
+            active = true;
+    }
+
+    led = effects_dim(led);
+    if (led != effects_led_level) {
+        pwm_set_gpio_level(effects_led_gpio, led);
+        effects_led_level = led;
+    }
+
+    if (memcmp(matrix, effects_matrix_out, sizeof(matrix)) != 0 || effects_matrix_dirty) {
+        // Se a DMA ainda estiver enviando o quadro anterior, tenta no próximo tick
+        bool lit = false;
+        for (int i = 0; i < NUM_PIXELS; i++)
+            lit |= (matrix[i] != 0);
+        if (effects_matrix && (lit || effects_matrix_lit) && !desenho_pio_dma_busy(effects_matrix)) {
+            memcpy(effects_matrix_out, matrix, sizeof(matrix));
+            desenho_pio_dma(effects_matrix_out, effects_matrix);
+            effects_matrix_lit = lit;
+            effects_matrix_dirty = false;
+        } else {
+            effects_matrix_dirty = (lit || effects_matrix_lit);
+        }
+    }
+
+    if (!active && !effects_matrix_dirty) {
+        effects_running = false;
+        return false;
+    }
+    return true;
+}
+
+static effect_t effects_start(uint8_t kind, const void *data, uint8_t count, uint8_t repeat) {
+    if (count == 0)
+        return 0;
+    effect_t id = 0;
+    bool start_timer = false;
+
+    uint32_t irq = save_and_disable_interrupts();
+    for (int s = 0; s < EFFECTS_MAX; s++) {
+        effect_slot_t *slot = &effects_slots[s];
+        if (slot->kind != EFFECT_KIND_NONE)
+            continue;
+        id = effects_next_id++;
+        if (effects_next_id == 0)
+            effects_next_id = 1;
+        slot->id = id;
+        slot->count = count;
+        slot->repeat = repeat;
+        slot->index = 0;
+        slot->elapsed_ms = 0;
+        if (kind == EFFECT_KIND_LED)
+            slot->keys = (const effect_key_t *)data;
+        else
+            slot->frames = (const effect_frame_t *)data;
+        slot->kind = kind;
+        start_timer = !effects_running;
+        effects_running = true;
+        break;
+    }
+    restore_interrupts(irq);
+
+    if (start_timer)
+        add_repeating_timer_ms(-EFFECTS_TICK_MS, effects_tick, NULL, &effects_timer);
+    return id;
+}
+
+effect_t effects_led_fade(const effect_key_t *keys, uint8_t count, uint8_t repeat) {
+    return effects_start(EFFECT_KIND_LED, keys, count, repeat);
+}
+
+effect_t effects_matrix_play(const effect_frame_t *frames, uint8_t count, uint8_t repeat) {
+    return effects_start(EFFECT_KIND_MATRIX, frames, count, repeat);
+}
+
+// O próximo tick recompõe a saída sem o efeito (e desliga o timer se não sobrar nenhum)
+void effects_cancel(effect_t effect) {
+    if (effect == 0)
+        return;
+    uint32_t irq = save_and_disable_interrupts();
+    for (int s = 0; s < EFFECTS_MAX; s++) {
+        if (effects_slots[s].kind != EFFECT_KIND_NONE && effects_slots[s].id == effect)
+            effects_slots[s].kind = EFFECT_KIND_NONE;
+    }
+    restore_interrupts(irq);
+}
+
+void effects_cancel_all(void) {
+    uint32_t irq = save_and_disable_interrupts();
+    for (int s = 0; s < EFFECTS_MAX; s++)
+        effects_slots[s].kind = EFFECT_KIND_NONE;
+    restore_interrupts(irq);
+}
+
+bool effects_is_running(effect_t effect) {
+    if (effect == 0)
+        return false;
+    for (int s = 0; s < EFFECTS_MAX; s++) {
+        if (effects_slots[s].kind != EFFECT_KIND_NONE && effects_slots[s].id == effect)
+            return true;
+    }
+    return false;
+}
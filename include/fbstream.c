@@ -0,0 +1,140 @@
+#include "fbstream.h"
+#include <string.h>
+#include "telemetry.h"
+
+// Pior caso de uma página de 128 bytes: cabeçalho + RLE de até width + 2 bytes
+#define FBSTREAM_PAGE_PAYLOAD_MAX (3 + 128 + 2)
+
+static bool fbstream_enabled = false;
+
+static uint8_t fbstream_current[FBSTREAM_MAX_BYTES];   // Quadro capturado em codificação
+static uint8_t fbstream_previous[FBSTREAM_MAX_BYTES];  // O que o host já tem
+static uint8_t fbstream_width = 0;
+static uint8_t fbstream_pages = 0;
+
+static bool fbstream_pending = false;     // Há um quadro capturado ainda não enviado
+static uint8_t fbstream_next_page = 0;    // Próxima página a codificar
+static uint8_t fbstream_changed = 0;      // Bitmap das páginas enviadas neste quadro
+static bool fbstream_keyframe = false;
+static uint16_t fbstream_seq = 0;
+
+static uint32_t fbstream_captured = 0;
+static uint32_t fbstream_skipped = 0;
+
+void fbstream_set_enabled(bool enabled) {
+    if (enabled && !fbstream_enabled) {
+        // Recomeça com um quadro-chave
+        fbstream_pending = false;
+        fbstream_seq = 0;
+    }
+    fbstream_enabled = enabled;
+}
+
+bool fbstream_is_enabled(void) {
+    return fbstream_enabled;
+}
+
+void fbstream_capture(const ssd1306_t *ssd) {
+    if (!fbstream_enabled)
+        return;
+    size_t size = ssd->bufsize - 1;
+    if (size > FBSTREAM_MAX_BYTES)
+        return;
+    if (fbstream_pending) {
+        fbstream_skipped++;
+        return;
+    }
+    memcpy(fbstream_current, ssd->ram_buffer + 1, size);
+    fbstream_width = ssd->width;
+    fbstream_pages = ssd->pages;
+    fbstream_next_page = 0;
+    fbstream_changed = 0;
+    fbstream_keyframe = (fbstream_seq % FBSTREAM_KEYFRAME_INTERVAL) == 0;
+    if (fbstream_keyframe)
+        memset(fbstream_previous, 0, size);
+    fbstream_pending = true;
+    fbstream_captured++;
+}
+
+// Quantos bytes a partir de 'i' são iguais ao quadro anterior (até 'max').
+static uint8_t fbstream_same_run(const uint8_t *cur, const uint8_t *prev, uint8_t i, uint8_t width, uint8_t max) {
+    uint8_t n = 0;
+    while (i + n < width && n < max && cur[i + n] == prev[i + n])
+        n++;
+    return n;
+}
+
+// Codifica o XOR da página contra o quadro anterior. Retorna o tamanho do RLE,
+// ou 0 se a página não mudou. Sequências de menos de 3 bytes inalterados entram
+// no literal (XOR 0), o que limita a saída a width + 2 bytes.
+static uint8_t fbstream_encode_page(const uint8_t *cur, const uint8_t *prev, uint8_t width, uint8_t *out) {
+    uint8_t len = 0;
+    uint8_t i = 0;
+    bool changed = false;
+    while (i < width) {
+        uint8_t same = fbstream_same_run(cur, prev, i, width, 128);
+        if (same >= 3 || i + same == width) {
+            out[len++] = same - 1;
+            i += same;
+            continue;
+        }
+        uint8_t header = len++;
+        uint8_t run = 0;
+        while (i < width && run < 128) {
+            uint8_t s = fbstream_same_run(cur, prev, i, width, 3);
+            if (s >= 3 || (s > 0 && i + s == width))
+                break;
+            out[len++] = cur[i] ^ prev[i];
+            i++;
+            run++;
+        }
+        out[header] = 0x7F + run;
+        changed = true;
+    }
+    return changed ? len : 0;
+}
+
+void fbstream_poll(void) {
+    if (!fbstream_pending)
+        return;
+
+    uint8_t payload[FBSTREAM_PAGE_PAYLOAD_MAX];
+    payload[0] = fbstream_seq & 0xFF;
+    payload[1] = fbstream_seq >> 8;
+
+    while (fbstream_next_page < fbstream_pages) {
+        // Só codifica se o pior caso couber; senão tenta de novo no próximo ocioso
+        if (telemetry_free() < FBSTREAM_PAGE_PAYLOAD_MAX + 4)
+            return;
+        uint8_t page = fbstream_next_page;
+        uint16_t offset = page * fbstream_width;
+        uint8_t len = fbstream_encode_page(&fbstream_current[offset], &fbstream_previous[offset],
+                                           fbstream_width, &payload[3]);
+        if (len || fbstream_keyframe) {
+            if (len == 0) {
+                // Página vazia em quadro-chave: um único run de bytes "inalterados"
+                payload[3] = fbstream_width - 1;
+                len = 1;
+            }
+            payload[2] = page | (fbstream_keyframe ? FBSTREAM_PAGE_KEY : 0);
+            telemetry_send(TLM_FRAME_FB_PAGE, payload, 3 + len);
+            fbstream_changed |= 1u << page;
+        }
+        memcpy(&fbstream_previous[offset], &fbstream_current[offset], fbstream_width);
+        fbstream_next_page++;
+    }
+
+    if (telemetry_free() < 5 + 4)
+        return;
+    payload[2] = fbstream_width;
+    payload[3] = fbstream_pages;
+    payload[4] = fbstream_changed;
+    telemetry_send(TLM_FRAME_FB_END, payload, 5);
+    fbstream_seq++;
+    fbstream_pending = false;
+}
+
+void fbstream_get_stats(uint32_t *captured, uint32_t *skipped) {
+    *captured = fbstream_captured;
+    *skipped = fbstream_skipped;
+}
@@ -0,0 +1,38 @@
+#ifndef FBSTREAM_H
+#define FBSTREAM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "ssd1306.h"
+
+// Maior framebuffer suportado (128x64, sem o byte de controle)
+#define FBSTREAM_MAX_BYTES 1024
+// A cada quantos quadros o delta é feito contra zero, para o host poder entrar no meio
+#define FBSTREAM_KEYFRAME_INTERVAL 32
+
+// Quadros de telemetria usados:
+//   TLM_FRAME_FB_PAGE: [seq u16][página u8 (bit 7 = quadro-chave)][RLE do XOR]
+//   TLM_FRAME_FB_END:  [seq u16][largura u8][páginas u8][bitmap de páginas alteradas u8]
+// RLE: byte 0x00-0x7F = (n + 1) bytes inalterados; 0x80-0xFF = (n - 0x7F) bytes XOR a seguir.
+// Páginas sem mudança não geram quadro: uma tela idêntica custa só o FB_END.
+#define FBSTREAM_PAGE_KEY 0x80
+
+// Estado inicial do streaming (CMake: -DSNAKE_FBSTREAM=ON)
+#ifndef FBSTREAM_ENABLED_AT_BOOT
+#define FBSTREAM_ENABLED_AT_BOOT 0
+#endif
+
+void fbstream_set_enabled(bool enabled);
+bool fbstream_is_enabled(void);
+
+// Gancho de ssd1306_send_data: copia o framebuffer se o codificador estiver livre.
+void fbstream_capture(const ssd1306_t *ssd);
+
+// Codifica e envia páginas pendentes enquanto houver espaço na telemetria.
+// Chamado no tempo ocioso, nunca dentro do tick.
+void fbstream_poll(void);
+
+// Quadros capturados e descartados (codificador ocupado)
+void fbstream_get_stats(uint32_t *captured, uint32_t *skipped);
+
+#endif // FBSTREAM_H
@@ -1,6 +1,7 @@
 #ifndef HIGHSCORE_H
 #define HIGHSCORE_H
 
+#include <stdbool.h>
 #include "ssd1306.h"  // Certifique-se de incluir o cabeçalho do OLED
 
 #define MAX_HIGH_SCORES 3
@@ -14,8 +15,15 @@ typedef struct {
 // Inicializa o placar com valores padrão.
 void init_high_scores();
 
-// Atualiza o placar se a pontuação for um novo recorde e solicita o nome do jogador.
-void update_high_scores(ssd1306_t *display, int score);
+// Indica se a pontuação entra no placar (novo recorde).
+bool high_score_qualifies(int score);
+
+// Exibe no OLED (e na serial) o pedido do nome do jogador; a leitura dos
+// caracteres fica com a máquina de estados (ui.c), sem bloquear.
+void high_score_prompt(ssd1306_t *display);
+
+// Insere o recorde na posição correta. Retorna a posição (0 = primeiro).
+int high_score_insert(int score, const char *name);
 
 // Exibe o placar na tela OLED.
 void display_scoreboard(ssd1306_t *display);
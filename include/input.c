@@ -0,0 +1,166 @@
+#include "input.h"
+#include <stdlib.h>
+#include "pico/stdlib.h"
+#include "hardware/adc.h"
+#include "hardware/sync.h"
+#include "config.h"
+#include "remote.h"
+
+#define INPUT_NO_DIRECTION (-1)
+
+static repeating_timer_t input_timer;
+static bool input_enabled = false;
+
+// Fila circular: escrita pelo callback do timer, lida pelo tick do jogo
+static input_turn_t input_queue[INPUT_QUEUE_DEPTH];
+static volatile uint8_t input_head = 0;
+static volatile uint8_t input_count = 0;
+
+// Última curva enfileirada (ou a direção atual, com a fila vazia)
+static volatile Direction input_last_dir = RIGHT;
+// Última leitura do joystick, para enfileirar só nas mudanças
+static volatile int input_last_sample = INPUT_NO_DIRECTION;
+
+static input_stats_t input_stats;
+
+static inline Direction input_opposite(Direction dir) {
+    return (Direction)((dir + 2) % 4);
+}
+
+// Lê o joystick e converte para uma direção, com a mesma média, zona morta e
+// correção de eixos que snake_update_direction usava.
+// Zona morta e número de leituras vêm de 'config' (ajustáveis pelo console).
+static int input_read_joystick(void) {
+    uint32_t total_x = 0, total_y = 0;
+    int samples = config.num_samples;
+    int dead_zone = config.dead_zone;
+    for (int i = 0; i < samples; i++) {
+        adc_select_input(JOYSTICK_X_ADC);
+        total_x += adc_read();
+        adc_select_input(JOYSTICK_Y_ADC);
+        total_y += adc_read();
+    }
+    // Realiza a troca: canal X → eixo Y, canal Y → eixo X
+    int16_t diff_y = (int16_t)(total_x / samples) - JOYSTICK_CENTER;
+    int16_t diff_x = (int16_t)(total_y / samples) - JOYSTICK_CENTER;
+
+    if (abs(diff_x) > abs(diff_y)) {
+        if (diff_x > dead_zone)
+            return RIGHT;
+        if (diff_x < -dead_zone)
+            return LEFT;
+    } else {
+        // Eixo Y invertido
+        if (diff_y > dead_zone)
+            return UP;
+        if (diff_y < -dead_zone)
+            return DOWN;
+    }
+    return INPUT_NO_DIRECTION;
+}
+
+// Regras comuns às fontes; chamada com as interrupções do amostrador bloqueadas
+static input_result_t input_enqueue(Direction dir, uint32_t timestamp_us, uint8_t source, uint8_t seq) {
+    // A proteção contra reversão usa a última curva enfileirada, não a direção atual
+    if (dir == input_last_dir || dir == input_opposite(input_last_dir)) {
+        input_stats.turns_rejected++;
+        return INPUT_REJECTED;
+    }
+    if (input_count == INPUT_QUEUE_DEPTH) {
+        input_stats.turns_dropped++;
+        return INPUT_DROPPED;
+    }
+    uint8_t tail = (input_head + input_count) % INPUT_QUEUE_DEPTH;
+    input_queue[tail].dir = dir;
+    input_queue[tail].timestamp_us = timestamp_us;
+    input_queue[tail].source = source;
+    input_queue[tail].seq = seq;
+    input_count++;
+    input_last_dir = dir;
+    input_stats.turns_queued++;
+    return INPUT_QUEUED;
+}
+
+static bool input_sample_callback(repeating_timer_t *rt) {
+    int sample = input_read_joystick();
+    if (sample == input_last_sample)
+        return true;
+
+    if (sample != INPUT_NO_DIRECTION &&
+        input_enqueue((Direction)sample, time_us_32(), INPUT_SOURCE_JOYSTICK, 0) == INPUT_DROPPED)
+        return true;  // Mantém input_last_sample para tentar de novo na próxima amostra
+    input_last_sample = sample;
+    return true;
+}
+
+void input_init(void) {
+    input_reset(RIGHT);
+    input_set_enabled(true);
+}
+
+void input_reset(Direction dir) {
+    input_turn_t flushed[INPUT_QUEUE_DEPTH];
+    uint8_t count;
+    uint32_t irq = save_and_disable_interrupts();
+    count = input_count;
+    for (uint8_t i = 0; i < count; i++)
+        flushed[i] = input_queue[(input_head + i) % INPUT_QUEUE_DEPTH];
+    input_head = 0;
+    input_count = 0;
+    input_last_dir = dir;
+    restore_interrupts(irq);
+
+    // Curvas remotas descartadas também são confirmadas, para o host não as
+    // dar como perdidas
+    for (uint8_t i = 0; i < count; i++) {
+        if (flushed[i].source == INPUT_SOURCE_REMOTE)
+            remote_ack(flushed[i].seq, REMOTE_FLUSHED, flushed[i].timestamp_us);
+    }
+}
+
+void input_set_enabled(bool enabled) {
+    if (enabled == input_enabled)
+        return;
+    if (enabled) {
+        input_last_sample = INPUT_NO_DIRECTION;
+        add_repeating_timer_ms(-INPUT_SAMPLE_PERIOD_MS, input_sample_callback, NULL, &input_timer);
+    } else {
+        cancel_repeating_timer(&input_timer);
+    }
+    input_enabled = enabled;
+}
+
+input_result_t input_push_turn(Direction dir, uint32_t timestamp_us, input_source_t source, uint8_t seq) {
+    if (!input_enabled)
+        return INPUT_DROPPED;
+    uint32_t irq = save_and_disable_interrupts();
+    input_result_t result = input_enqueue(dir, timestamp_us, source, seq);
+    restore_interrupts(irq);
+    return result;
+}
+
+bool input_pop_turn(input_turn_t *turn) {
+    uint32_t irq = save_and_disable_interrupts();
+    if (input_count == 0) {
+        restore_interrupts(irq);
+        return false;
+    }
+    *turn = input_queue[input_head];
+    input_head = (input_head + 1) % INPUT_QUEUE_DEPTH;
+    input_count--;
+    restore_interrupts(irq);
+
+    uint32_t latency = time_us_32() - turn->timestamp_us;
+    input_stats.last_latency_us = latency;
+    if (latency > input_stats.max_latency_us)
+        input_stats.max_latency_us = latency;
+    if (turn->source == INPUT_SOURCE_REMOTE)
+        remote_ack(turn->seq, REMOTE_APPLIED, turn->timestamp_us);
+    return true;
+}
+
+void input_get_stats(input_stats_t *stats) {
+    uint32_t irq = save_and_disable_interrupts();
+    *stats = input_stats;
+    restore_interrupts(irq);
+}
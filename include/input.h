@@ -0,0 +1,61 @@
+#ifndef INPUT_H
+#define INPUT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "snake.h"
+
+// Amostragem do joystick em alta taxa, independente do tick do jogo
+#define INPUT_SAMPLE_PERIOD_MS 5
+// Quantas curvas podem ser enfileiradas entre dois ticks
+#define INPUT_QUEUE_DEPTH 3
+
+// Origem de uma curva: as duas dividem a fila, com a mesma prioridade
+typedef enum {
+    INPUT_SOURCE_JOYSTICK = 0,
+    INPUT_SOURCE_REMOTE,      // Pacote pela serial (remote.h)
+} input_source_t;
+
+// Curva registrada, com o instante em que foi detectada (ou recebida)
+typedef struct {
+    Direction dir;
+    uint32_t timestamp_us;
+    uint8_t source;           // input_source_t
+    uint8_t seq;              // Número do pacote remoto
+} input_turn_t;
+
+typedef enum {
+    INPUT_QUEUED = 0,
+    INPUT_REJECTED,           // Repetição ou reversão da última curva
+    INPUT_DROPPED,            // Fila cheia ou amostragem desligada
+} input_result_t;
+
+typedef struct {
+    uint32_t turns_queued;    // Curvas aceitas na fila
+    uint32_t turns_rejected;  // Repetições ou reversões da última curva enfileirada
+    uint32_t turns_dropped;   // Fila cheia
+    uint32_t last_latency_us; // Da detecção até o tick que aplicou a curva
+    uint32_t max_latency_us;
+} input_stats_t;
+
+// Inicia o timer de amostragem (o ADC já deve estar inicializado).
+void input_init(void);
+
+// Esvazia a fila (as curvas remotas nela são confirmadas como descartadas);
+// 'dir' passa a ser a referência para a proteção contra reversão.
+void input_reset(Direction dir);
+
+// Suspende/retoma a amostragem (ex.: em pausa, para não acordar o núcleo).
+void input_set_enabled(bool enabled);
+
+// Enfileira uma curva de outra fonte, com as mesmas regras do joystick.
+// Chamado do laço principal; ignorada com a amostragem desligada.
+input_result_t input_push_turn(Direction dir, uint32_t timestamp_us, input_source_t source, uint8_t seq);
+
+// Retira a curva mais antiga da fila (as remotas são confirmadas ao host).
+// Retorna false se a fila estiver vazia.
+bool input_pop_turn(input_turn_t *turn);
+
+void input_get_stats(input_stats_t *stats);
+
+#endif // INPUT_H
@@ -0,0 +1,110 @@
+#include "logger.h"
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "hardware/sync.h"
+
+#if LIB_PICO_STDIO_USB
+#include "pico/stdio_usb.h"
+#include "tusb.h"
+#endif
+
+#define LOGGER_MASK (LOGGER_BUFFER_ENTRIES - 1)
+
+static logger_entry_t logger_buffer[LOGGER_BUFFER_ENTRIES];
+static volatile uint32_t logger_head = 0;
+static volatile uint32_t logger_tail = 0;
+static volatile uint32_t logger_dropped = 0;
+
+// Pode ser chamada de interrupções: a reserva da posição é feita com as
+// interrupções mascaradas, o que custa poucas instruções no M0+.
+void logger_record(uint8_t level, const char *fmt, uint8_t nargs,
+                   uint32_t a0, uint32_t a1, uint32_t a2, uint32_t a3) {
+    uint32_t irq = save_and_disable_interrupts();
+    uint32_t head = logger_head;
+    if (head - logger_tail >= LOGGER_BUFFER_ENTRIES) {
+        logger_dropped++;
+        restore_interrupts(irq);
+        return;
+    }
+    logger_entry_t *entry = &logger_buffer[head & LOGGER_MASK];
+    entry->fmt = fmt;
+    entry->timestamp_us = time_us_32();
+    entry->level = level;
+    entry->nargs = nargs;
+    entry->args[0] = a0;
+    entry->args[1] = a1;
+    entry->args[2] = a2;
+    entry->args[3] = a3;
+    logger_head = head + 1;
+    restore_interrupts(irq);
+}
+
+bool logger_pop(logger_entry_t *entry) {
+    uint32_t tail = logger_tail;
+    if (tail == logger_head)
+        return false;
+    *entry = logger_buffer[tail & LOGGER_MASK];
+    __dmb();
+    logger_tail = tail + 1;
+    return true;
+}
+
+// Espaço no FIFO do CDC, como em telemetry_poll: sem host (ou sem USB) a
+// saída não espera e não há limite
+static uint32_t logger_out_room(void) {
+#if LIB_PICO_STDIO_USB
+    if (stdio_usb_connected())
+        return tud_cdc_write_available();
+#endif
+    return UINT32_MAX;
+}
+
+// Bytes que a linha ocupa no FIFO: o stdio troca cada \n por \r\n
+static uint32_t logger_out_len(const char *line, int len) {
+    uint32_t total = (uint32_t)len;
+    for (int i = 0; i < len; i++)
+        total += line[i] == '\n';
+    return total;
+}
+
+void logger_drain(void) {
+    static const char level_tag[] = "-EWID";
+    static uint32_t reported_drops = 0;
+    char line[LOGGER_LINE_MAX];
+    uint32_t room = logger_out_room();
+
+    // Cada entrada só sai se couber inteira no FIFO; senão fica no buffer
+    // para o próximo dreno, e o printf nunca espera pelo host
+    for (int i = 0; i < LOGGER_DRAIN_PER_POLL && logger_tail != logger_head; i++) {
+        const logger_entry_t *entry = &logger_buffer[logger_tail & LOGGER_MASK];
+        int len = snprintf(line, sizeof(line), "[%8lu] %c ",
+                           (unsigned long)(entry->timestamp_us / 1000), level_tag[entry->level]);
+        // Argumentos além dos usados pelo formato são ignorados
+        int msg = snprintf(line + len, sizeof(line) - len, entry->fmt,
+                           entry->args[0], entry->args[1], entry->args[2], entry->args[3]);
+        len += msg < 0 ? 0 : msg;
+        if (len >= (int)sizeof(line))
+            len = sizeof(line) - 1;  // Truncada
+        uint32_t need = logger_out_len(line, len);
+        if (need > room)
+            break;
+        printf("%.*s", len, line);
+        room -= need;
+        __dmb();
+        logger_tail++;
+    }
+
+    uint32_t dropped = logger_dropped;
+    if (dropped != reported_drops) {
+        int len = snprintf(line, sizeof(line), "[log] %lu mensagens descartadas\n",
+                           (unsigned long)(dropped - reported_drops));
+        if (logger_out_len(line, len) <= room) {
+            printf("%.*s", len, line);
+            reported_drops = dropped;
+        }
+    }
+}
+
+uint32_t logger_get_dropped(void) {
+    return logger_dropped;
+}
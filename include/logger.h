@@ -0,0 +1,87 @@
+#ifndef LOGGER_H
+#define LOGGER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Níveis de log; LOG_LEVEL escolhe em tempo de compilação o nível máximo gravado.
+// Chamadas acima do nível viram ((void)0): nem os argumentos são avaliados.
+#define LOG_LEVEL_NONE  0
+#define LOG_LEVEL_ERROR 1
+#define LOG_LEVEL_WARN  2
+#define LOG_LEVEL_INFO  3
+#define LOG_LEVEL_DEBUG 4
+
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_INFO
+#endif
+
+// Entradas no buffer circular (potência de 2)
+#define LOGGER_BUFFER_ENTRIES 32
+#define LOGGER_MAX_ARGS 4
+// Entradas formatadas por chamada de logger_drain
+#define LOGGER_DRAIN_PER_POLL 4
+// Linha formatada (cabeçalho + mensagem); o excesso é cortado
+#define LOGGER_LINE_MAX 128
+
+// Uma entrada guarda só o ponteiro do formato (que também serve de ID, pois a
+// string fica na flash) e os argumentos crus; a formatação acontece no dreno.
+// Argumentos são convertidos para uint32_t: inteiros, caracteres e ponteiros
+// para strings que continuem válidas até o dreno. Sem ponto flutuante.
+typedef struct {
+    const char *fmt;
+    uint32_t timestamp_us;
+    uint8_t level;
+    uint8_t nargs;
+    uint32_t args[LOGGER_MAX_ARGS];
+} logger_entry_t;
+
+void logger_record(uint8_t level, const char *fmt, uint8_t nargs,
+                   uint32_t a0, uint32_t a1, uint32_t a2, uint32_t a3);
+
+// Formata até LOGGER_DRAIN_PER_POLL entradas, só as que cabem no FIFO do USB
+// CDC (as demais esperam o próximo dreno). Chamado no tempo ocioso.
+void logger_drain(void);
+
+// Retira a próxima entrada sem formatar (para ferramentas que formatam no host).
+bool logger_pop(logger_entry_t *entry);
+
+uint32_t logger_get_dropped(void);
+
+// Seleção da variante pelo número de argumentos (formato + até 4 valores)
+#define LOGGER_ARG_(x) ((uint32_t)(uintptr_t)(x))
+#define LOGGER_RECORD_0_(l, f)             logger_record(l, f, 0, 0, 0, 0, 0)
+#define LOGGER_RECORD_1_(l, f, a)          logger_record(l, f, 1, LOGGER_ARG_(a), 0, 0, 0)
+#define LOGGER_RECORD_2_(l, f, a, b)       logger_record(l, f, 2, LOGGER_ARG_(a), LOGGER_ARG_(b), 0, 0)
+#define LOGGER_RECORD_3_(l, f, a, b, c)    logger_record(l, f, 3, LOGGER_ARG_(a), LOGGER_ARG_(b), LOGGER_ARG_(c), 0)
+#define LOGGER_RECORD_4_(l, f, a, b, c, d) logger_record(l, f, 4, LOGGER_ARG_(a), LOGGER_ARG_(b), LOGGER_ARG_(c), LOGGER_ARG_(d))
+#define LOGGER_PICK_(_1, _2, _3, _4, _5, NAME, ...) NAME
+#define LOGGER_RECORD(l, ...) \
+    LOGGER_PICK_(__VA_ARGS__, LOGGER_RECORD_4_, LOGGER_RECORD_3_, LOGGER_RECORD_2_, \
+                 LOGGER_RECORD_1_, LOGGER_RECORD_0_, _)(l, __VA_ARGS__)
+
+#if LOG_LEVEL >= LOG_LEVEL_ERROR
+#define LOG_ERROR(...) LOGGER_RECORD(LOG_LEVEL_ERROR, __VA_ARGS__)
+#else
+#define LOG_ERROR(...) ((void)0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_WARN
+#define LOG_WARN(...) LOGGER_RECORD(LOG_LEVEL_WARN, __VA_ARGS__)
+#else
+#define LOG_WARN(...) ((void)0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_INFO
+#define LOG_INFO(...) LOGGER_RECORD(LOG_LEVEL_INFO, __VA_ARGS__)
+#else
+#define LOG_INFO(...) ((void)0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(...) LOGGER_RECORD(LOG_LEVEL_DEBUG, __VA_ARGS__)
+#else
+#define LOG_DEBUG(...) ((void)0)
+#endif
+
+#endif // LOGGER_H
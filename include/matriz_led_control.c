@@ -1,20 +1,29 @@
 #include "matriz_led_control.h"
+#include "logger.h"
+#include "hardware/dma.h"
 // #include "buzzer_functions.h"
 
 void init_pio_routine(pio_t * meu_pio, uint OUT_PIN)
 {
-    //coloca a frequência de clock para 128 MHz, facilitando a divisão pelo clock
-    meu_pio->ok = set_sys_clock_khz(128000, false);
+    //a temporização da PIO conta com o clock de 128 MHz, ajustado no início do main
+    meu_pio->ok = clock_get_hz(clk_sys) == 128000000u;
 
-    stdio_init_all();
-
-    printf("iniciando a transmissão PIO");
-    if (meu_pio->ok) printf("clock set to %ld\n", clock_get_hz(clk_sys));
+    LOG_INFO("iniciando a transmissao PIO\n");
+    if (!meu_pio->ok) LOG_WARN("clock de %lu Hz, esperado 128 MHz\n", clock_get_hz(clk_sys));
 
     //configurações da PIO
     uint offset = pio_add_program(meu_pio->pio, &pio_matrix_program);
     meu_pio->sm = pio_claim_unused_sm(meu_pio->pio, true);
     pio_matrix_program_init(meu_pio->pio, meu_pio->sm, offset, OUT_PIN);
+
+    //canal de DMA que alimenta o FIFO da state machine, no ritmo do DREQ da PIO
+    meu_pio->dma_chan = dma_claim_unused_channel(true);
+    dma_channel_config cfg = dma_channel_get_default_config(meu_pio->dma_chan);
+    channel_config_set_transfer_data_size(&cfg, DMA_SIZE_32);
+    channel_config_set_read_increment(&cfg, true);
+    channel_config_set_write_increment(&cfg, false);
+    channel_config_set_dreq(&cfg, pio_get_dreq(meu_pio->pio, meu_pio->sm, true));
+    dma_channel_configure(meu_pio->dma_chan, &cfg, &meu_pio->pio->txf[meu_pio->sm], NULL, NUM_PIXELS, false);
 }
 
 //imprimir valor binário
@@ -36,7 +45,7 @@ uint32_t matrix_rgb(double b, double r, double g)
   return (G << 24) | (R << 16) | (B << 8);
 }
 
-void desenho_pio(double *desenho, pio_t *meu_pio)
+void desenho_pio(const double *desenho, pio_t *meu_pio)
 {
     uint32_t valor_led = 0;
 
@@ -45,11 +54,11 @@ void desenho_pio(double *desenho, pio_t *meu_pio)
         pio_sm_put_blocking(meu_pio->pio, meu_pio->sm, valor_led);
         //imprimir_binario(valor_led);
     }
-    printf("clock set to %ld\n", clock_get_hz(clk_sys));
+    LOG_DEBUG("clock set to %lu\n", clock_get_hz(clk_sys));
 }
 
 
-void desenho_pio_rgb(double *desenho, pio_t * meu_pio)
+void desenho_pio_rgb(const double *desenho, pio_t * meu_pio)
 {
     uint32_t valor_led = 0;
 
@@ -58,7 +67,7 @@ void desenho_pio_rgb(double *desenho, pio_t * meu_pio)
         pio_sm_put_blocking(meu_pio->pio, meu_pio->sm, valor_led);
         //imprimir_binario(valor_led);
     }
-    printf("clock set to %ld\n", clock_get_hz(clk_sys));
+    LOG_DEBUG("clock set to %lu\n", clock_get_hz(clk_sys));
 }
 
 
@@ -71,5 +80,15 @@ void desliga_tudo(pio_t * meu_pio)
         pio_sm_put_blocking(meu_pio->pio, meu_pio->sm, valor_led);
         //imprimir_binario(valor_led);
     }
-    printf("clock set to %ld\n", clock_get_hz(clk_sys));
-}
\ No newline at end of file
+    LOG_DEBUG("clock set to %lu\n", clock_get_hz(clk_sys));
+}
+
+void desenho_pio_dma(const uint32_t *valores, pio_t * meu_pio)
+{
+    dma_channel_transfer_from_buffer_now(meu_pio->dma_chan, valores, NUM_PIXELS);
+}
+
+bool desenho_pio_dma_busy(pio_t * meu_pio)
+{
+    return dma_channel_is_busy(meu_pio->dma_chan);
+}
@@ -17,14 +17,19 @@ typedef struct {
     double g;
     double b;
     uint sm;
+    int dma_chan;   // Canal de DMA para envio de quadros sem bloquear
 } pio_t;
 
 void init_pio_routine(pio_t * meu_pio, uint OUT_PIN);
 void imprimir_binario(int num) ;
 uint32_t matrix_rgb(double b, double r, double g);
-void desenho_pio(double *desenho, pio_t * meu_pio);
-void desenho_pio_rgb(double *desenho, pio_t * meu_pio);
+void desenho_pio(const double *desenho, pio_t * meu_pio);
+void desenho_pio_rgb(const double *desenho, pio_t * meu_pio);
 void desliga_tudo(pio_t * meu_pio);
+// Envia NUM_PIXELS valores já no formato de matrix_rgb por DMA e retorna na hora.
+// O buffer precisa continuar válido até desenho_pio_dma_busy() retornar false.
+void desenho_pio_dma(const uint32_t *valores, pio_t * meu_pio);
+bool desenho_pio_dma_busy(pio_t * meu_pio);
 
 
 
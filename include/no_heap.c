@@ -0,0 +1,11 @@
+// Build sem heap (SNAKE_STATIC_ALLOC): o linker redireciona _sbrk para cá
+// (-Wl,--wrap=_sbrk). Todo malloc/calloc/realloc da newlib, inclusive os
+// internos da biblioteca e os do pico_malloc (que já embrulha malloc e
+// companhia), cresce o heap por _sbrk, então o primeiro uso do heap para a
+// placa com a mensagem em vez de passar despercebido.
+
+#include "pico/stdlib.h"
+
+void *__wrap__sbrk(int incr) {
+    panic("heap usado num build sem heap (SNAKE_NO_HEAP), %d bytes", incr);
+}
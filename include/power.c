@@ -0,0 +1,146 @@
+#include "power.h"
+#include "audio.h"
+#include <stdio.h>
+#include "hardware/clocks.h"
+#include "hardware/pio.h"
+#include "hardware/pwm.h"
+#include "hardware/uart.h"
+#include "hardware/sync.h"
+
+// Periféricos que precisam ter o divisor recalculado a cada troca de clock
+static pio_t *power_led_matrix = NULL;
+static i2c_inst_t *power_i2c = NULL;
+static uint power_i2c_baudrate = 0;
+static uint power_pwm_gpio = 0;
+
+static power_state_t power_state = POWER_STATE_ACTIVE;
+static uint64_t power_state_since = 0;
+static power_stats_t power_stats;
+
+void power_init(pio_t *led_matrix, i2c_inst_t *i2c, uint i2c_baudrate, uint pwm_gpio) {
+    power_led_matrix = led_matrix;
+    power_i2c = i2c;
+    power_i2c_baudrate = i2c_baudrate;
+    power_pwm_gpio = pwm_gpio;
+
+    power_state = POWER_STATE_ACTIVE;
+    power_state_since = time_us_64();
+    power_stats.entries[POWER_STATE_ACTIVE] = 1;
+}
+
+// Reaplica os divisores para que PIO, I2C, UART e áudio mantenham suas taxas no novo clk_sys.
+// (set_sys_clock_* também move o clk_peri, que alimenta I2C e UART.)
+static void power_apply_dividers(void) {
+    uint32_t sys_hz = clock_get_hz(clk_sys);
+
+    // Mesmo cálculo de pio_matrix_program_init: 8 MHz, 10 ciclos por bit do WS2812
+    if (power_led_matrix && power_led_matrix->pio)
+        pio_sm_set_clkdiv(power_led_matrix->pio, power_led_matrix->sm, sys_hz / 8000000.0f);
+
+    if (power_i2c)
+        i2c_set_baudrate(power_i2c, power_i2c_baudrate);
+
+#if LIB_PICO_STDIO_UART
+    uart_set_baudrate(PICO_DEFAULT_UART_INSTANCE, PICO_DEFAULT_UART_BAUD_RATE);
+#endif
+
+    // Um efeito sonoro pode estar tocando durante a troca (ex.: explosão no Game Over)
+    audio_retime();
+}
+
+void power_set_i2c_baudrate(uint32_t baudrate) {
+    power_i2c_baudrate = baudrate;
+    if (power_i2c)
+        i2c_set_baudrate(power_i2c, baudrate);
+}
+
+// Soma o intervalo decorrido ao estado atual e passa para o próximo.
+static void power_account(power_state_t next) {
+    uint64_t now = time_us_64();
+    power_stats.time_us[power_state] += now - power_state_since;
+    power_stats.entries[next]++;
+    power_state_since = now;
+    power_state = next;
+}
+
+void power_enter(power_state_t state) {
+    if (state == POWER_STATE_ACTIVE) {
+        power_exit();
+        return;
+    }
+    if (state == power_state)
+        return;
+    bool was_active = (power_state == POWER_STATE_ACTIVE);
+    power_account(state);
+
+    if (was_active) {
+        // O LED azul fica apagado em espera; o PWM não precisa acompanhar o clock
+        pwm_set_gpio_level(power_pwm_gpio, 0);
+        // set_sys_clock_48mhz troca o clk_sys para a pll_usb e desliga a pll_sys
+        _Static_assert(POWER_IDLE_KHZ == 48000, "POWER_IDLE_KHZ precisa ser o clock de set_sys_clock_48mhz");
+        set_sys_clock_48mhz();
+        power_apply_dividers();
+    }
+}
+
+void power_exit(void) {
+    if (power_state != POWER_STATE_ACTIVE)
+        power_account(POWER_STATE_ACTIVE);
+    if (clock_get_hz(clk_sys) == POWER_ACTIVE_KHZ * 1000u)
+        return;
+
+    set_sys_clock_khz(POWER_ACTIVE_KHZ, true);
+    power_apply_dividers();
+
+    // Restaura a configuração do LED azul feita em setup_blue_led
+    uint slice = pwm_gpio_to_slice_num(power_pwm_gpio);
+    pwm_set_clkdiv(slice, 1.0f);
+    pwm_set_wrap(slice, 255);
+}
+
+// Só serve para acordar o núcleo do __wfi no prazo pedido
+static int64_t power_alarm_callback(alarm_id_t id, void *user_data) {
+    return 0;
+}
+
+// Com as interrupções mascaradas, uma IRQ pendente ainda acorda o __wfi; isso evita
+// perder o evento que chega entre o teste da condição e o sono.
+void power_sleep_until(absolute_time_t until, bool (*wake)(void)) {
+    alarm_id_t alarm = 0;
+    if (!is_at_the_end_of_time(until)) {
+        if (time_reached(until))
+            return;
+        alarm = add_alarm_at(until, power_alarm_callback, NULL, false);
+    }
+    while (true) {
+        uint32_t irq = save_and_disable_interrupts();
+        if ((wake && wake()) || time_reached(until)) {
+            restore_interrupts(irq);
+            break;
+        }
+        __wfi();
+        restore_interrupts(irq);
+    }
+    if (alarm > 0)
+        cancel_alarm(alarm);
+}
+
+power_state_t power_get_state(void) {
+    return power_state;
+}
+
+void power_get_stats(power_stats_t *stats) {
+    *stats = power_stats;
+    // Inclui o intervalo ainda em andamento
+    stats->time_us[power_state] += time_us_64() - power_state_since;
+}
+
+void power_print_stats(void) {
+    static const char *names[POWER_STATE_COUNT] = {"ativo", "pausa", "espera"};
+    power_stats_t stats;
+    power_get_stats(&stats);
+    for (int i = 0; i < POWER_STATE_COUNT; i++) {
+        printf("%-7s %10lu ms  %5lu entradas\n", names[i],
+               (unsigned long)(stats.time_us[i] / 1000), (unsigned long)stats.entries[i]);
+    }
+}
@@ -0,0 +1,47 @@
+#ifndef POWER_H
+#define POWER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+#include "matriz_led_control.h"
+
+// Frequências do clock do sistema (em kHz)
+#define POWER_ACTIVE_KHZ 128000  // Durante o jogo (mesma frequência exigida pela PIO da matriz)
+#define POWER_IDLE_KHZ   48000   // Em espera: clk_sys passa para a pll_usb e a pll_sys é desligada
+
+// Estados de energia contabilizados
+typedef enum {
+    POWER_STATE_ACTIVE = 0,  // Jogo rodando, clock cheio
+    POWER_STATE_PAUSED,      // Jogo pausado pelo botão A
+    POWER_STATE_WAIT,        // Aguardando o botão do joystick (Game Over / placar)
+    POWER_STATE_COUNT
+} power_state_t;
+
+// Tempo acumulado e número de entradas em cada estado
+typedef struct {
+    uint64_t time_us[POWER_STATE_COUNT];
+    uint32_t entries[POWER_STATE_COUNT];
+} power_stats_t;
+
+// Registra os periféricos cujos divisores dependem do clk_sys.
+void power_init(pio_t *led_matrix, i2c_inst_t *i2c, uint i2c_baudrate, uint pwm_gpio);
+
+// Reduz o clock e entra no estado informado / restaura o clock cheio.
+void power_enter(power_state_t state);
+void power_exit(void);
+
+// Dorme em __wfi, no clock do estado atual, até o instante 'until' ou até
+// wake() retornar true (testado a cada interrupção). Com at_the_end_of_time,
+// só wake() encerra a espera.
+void power_sleep_until(absolute_time_t until, bool (*wake)(void));
+
+// Novo clock do I2C do OLED, mantido também nas trocas de clock
+void power_set_i2c_baudrate(uint32_t baudrate);
+
+power_state_t power_get_state(void);
+void power_get_stats(power_stats_t *stats);
+void power_print_stats(void);
+
+#endif // POWER_H
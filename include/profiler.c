@@ -0,0 +1,180 @@
+#include "profiler.h"
+#include <string.h>
+#include "pico/stdlib.h"
+
+#if PROFILER_ENABLED
+
+#include "hardware/irq.h"
+#include "hardware/timer.h"
+#include "hardware/watchdog.h"
+#include "deadline.h"
+#include "telemetry.h"
+
+typedef struct {
+    uint32_t pc;
+    uint32_t lr;
+    uint8_t stage;
+} profiler_sample_t;
+
+// Buffer circular: escrito só pela interrupção, lido só pelo laço principal.
+// Os índices correm livres (uint16_t) e o head também numera as amostras.
+static profiler_sample_t profiler_ring[PROFILER_BUFFER_SIZE];
+static volatile uint16_t profiler_head = 0;
+static volatile uint16_t profiler_tail = 0;
+static volatile uint32_t profiler_samples = 0;
+static volatile uint32_t profiler_dropped = 0;
+static uint32_t profiler_dropped_reported = 0;
+static uint32_t profiler_sent = 0;
+
+static int profiler_alarm = -1;            // Alarme de hardware próprio (fora do pool do SDK)
+static uint32_t profiler_period_us = 0;
+static uint32_t profiler_target = 0;       // Próximo disparo (timerawl)
+static uint16_t profiler_hz = 0;
+
+// Chamada pela entrada em assembly com o quadro que o hardware empilhou na
+// exceção: r0, r1, r2, r3, r12, lr, pc, xpsr.
+void __attribute__((used)) profiler_sample(const uint32_t *frame) {
+    timer_hw->intr = 1u << profiler_alarm;
+    // Próximo disparo sem acumular atraso; se as interrupções ficaram mascaradas
+    // além de um período, realinha (o alarme só compara os 32 bits baixos)
+    uint32_t now = timer_hw->timerawl;
+    profiler_target += profiler_period_us;
+    if ((int32_t)(profiler_target - now) <= 0)
+        profiler_target = now + profiler_period_us;
+    timer_hw->alarm[profiler_alarm] = profiler_target;
+
+    uint16_t head = profiler_head;
+    if ((uint16_t)(head - profiler_tail) >= PROFILER_BUFFER_SIZE) {
+        profiler_dropped++;
+        return;
+    }
+    profiler_sample_t *sample = &profiler_ring[head & (PROFILER_BUFFER_SIZE - 1)];
+    sample->pc = frame[6];
+    sample->lr = frame[5];
+    sample->stage = (uint8_t)watchdog_hw->scratch[DEADLINE_SCRATCH_STAGE];
+    profiler_head = head + 1;
+    profiler_samples++;
+}
+
+// Um handler em C empilharia registradores antes de qualquer código nosso;
+// esta entrada só escolhe a pilha em uso (bit 2 do EXC_RETURN em lr) e segue
+// para profiler_sample, que retorna direto da exceção.
+static void __attribute__((naked)) profiler_irq(void) {
+    __asm volatile(
+        ".syntax unified\n"
+        "movs r0, #4\n"
+        "mov r1, lr\n"
+        "tst r0, r1\n"
+        "beq 1f\n"
+        "mrs r0, psp\n"
+        "b 2f\n"
+        "1:\n"
+        "mrs r0, msp\n"
+        "2:\n"
+        "ldr r1, =profiler_sample\n"
+        "bx r1\n");
+}
+
+static void profiler_stop(void) {
+    uint irq = TIMER_IRQ_0 + profiler_alarm;
+    irq_set_enabled(irq, false);
+    timer_hw->armed = 1u << profiler_alarm;  // Escrever 1 desarma
+    timer_hw->intr = 1u << profiler_alarm;
+    profiler_hz = 0;
+}
+
+bool profiler_start(uint32_t hz) {
+    if (hz > PROFILER_MAX_HZ)
+        return false;
+    if (profiler_alarm < 0) {
+        if (hz == 0)
+            return true;
+        profiler_alarm = hardware_alarm_claim_unused(false);
+        if (profiler_alarm < 0)
+            return false;
+        uint irq = TIMER_IRQ_0 + profiler_alarm;
+        irq_set_exclusive_handler(irq, profiler_irq);
+        // Prioridade máxima: as amostras caem também dentro das outras interrupções
+        irq_set_priority(irq, PICO_HIGHEST_IRQ_PRIORITY);
+        hw_set_bits(&timer_hw->inte, 1u << profiler_alarm);
+    }
+
+    profiler_stop();
+    if (hz == 0)
+        return true;
+    profiler_hz = (uint16_t)hz;
+    profiler_period_us = 1000000u / hz;
+    profiler_target = timer_hw->timerawl + profiler_period_us;
+    timer_hw->alarm[profiler_alarm] = profiler_target;
+    irq_set_enabled(TIMER_IRQ_0 + profiler_alarm, true);
+    return true;
+}
+
+static void profiler_put_u32(uint8_t *out, uint32_t v) {
+    out[0] = v & 0xFF;
+    out[1] = (v >> 8) & 0xFF;
+    out[2] = (v >> 16) & 0xFF;
+    out[3] = (v >> 24) & 0xFF;
+}
+
+void profiler_poll(void) {
+    uint8_t payload[PROFILER_HEADER_BYTES + PROFILER_SAMPLES_PER_FRAME * PROFILER_SAMPLE_BYTES];
+    while (true) {
+        uint16_t tail = profiler_tail;
+        uint16_t n = (uint16_t)(profiler_head - tail);
+        if (n == 0)
+            return;
+        if (n > PROFILER_SAMPLES_PER_FRAME)
+            n = PROFILER_SAMPLES_PER_FRAME;
+        uint8_t len = PROFILER_HEADER_BYTES + n * PROFILER_SAMPLE_BYTES;
+        // Espera espaço em vez de deixar a telemetria descartar o quadro
+        if (telemetry_free() < (uint32_t)len + 4)
+            return;
+
+        uint32_t dropped = profiler_dropped;
+        uint32_t lost = dropped - profiler_dropped_reported;
+        if (lost > 0xFFFF)
+            lost = 0xFFFF;
+        payload[0] = tail & 0xFF;
+        payload[1] = tail >> 8;
+        payload[2] = profiler_hz & 0xFF;
+        payload[3] = profiler_hz >> 8;
+        payload[4] = lost & 0xFF;
+        payload[5] = lost >> 8;
+        uint8_t *out = payload + PROFILER_HEADER_BYTES;
+        for (uint16_t i = 0; i < n; i++) {
+            const profiler_sample_t *sample = &profiler_ring[(uint16_t)(tail + i) & (PROFILER_BUFFER_SIZE - 1)];
+            profiler_put_u32(out, sample->pc);
+            profiler_put_u32(out + 4, sample->lr);
+            out[8] = sample->stage;
+            out += PROFILER_SAMPLE_BYTES;
+        }
+        if (!telemetry_send(TLM_FRAME_PROFILE, payload, len))
+            return;
+        profiler_dropped_reported = dropped;
+        profiler_tail = tail + n;
+        profiler_sent += n;
+    }
+}
+
+void profiler_get_stats(profiler_stats_t *stats) {
+    stats->samples = profiler_samples;
+    stats->dropped = profiler_dropped;
+    stats->sent = profiler_sent;
+    stats->hz = profiler_hz;
+}
+
+#else
+
+bool profiler_start(uint32_t hz) {
+    return hz == 0;
+}
+
+void profiler_poll(void) {
+}
+
+void profiler_get_stats(profiler_stats_t *stats) {
+    memset(stats, 0, sizeof(*stats));
+}
+
+#endif // PROFILER_ENABLED
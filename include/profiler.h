@@ -0,0 +1,51 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Perfilador por amostragem: um alarme de hardware interrompe o núcleo numa
+// taxa fixa e a interrupção guarda o PC interrompido (e o LR, que aponta o
+// chamador de funções folha) com o estágio do laço em andamento (deadline.h)
+// num buffer circular. O laço principal drena as amostras para quadros de
+// telemetria no tempo ocioso; tools/profile.py as simboliza contra o ELF.
+//
+// Só entra no build com -DSNAKE_PROFILER=ON; sem isso as funções não fazem nada.
+
+#ifndef PROFILER_ENABLED
+#define PROFILER_ENABLED 0
+#endif
+// Amostras por segundo desde o boot (CMake: SNAKE_PROFILER_HZ; 0 = parado até 'prof <hz>')
+#ifndef PROFILER_HZ_AT_BOOT
+#define PROFILER_HZ_AT_BOOT 0
+#endif
+
+#define PROFILER_MAX_HZ 10000
+#define PROFILER_BUFFER_SIZE 256         // Amostras (potência de 2)
+#define PROFILER_SAMPLES_PER_FRAME 24    // Cabem num quadro de telemetria
+
+// Quadro de telemetria TLM_FRAME_PROFILE:
+//   [seq u16][taxa u16 em Hz][perdidas u16][n x (pc u32, lr u32, estágio u8)]
+// seq numera as amostras guardadas (um salto = quadros perdidos na telemetria);
+// perdidas conta as descartadas com o buffer cheio desde o quadro anterior.
+#define PROFILER_HEADER_BYTES 6
+#define PROFILER_SAMPLE_BYTES 9
+
+typedef struct {
+    uint32_t samples;     // Amostras guardadas
+    uint32_t dropped;     // Descartadas com o buffer cheio
+    uint32_t sent;        // Enviadas pela telemetria
+    uint16_t hz;          // Taxa atual (0 = parado)
+} profiler_stats_t;
+
+// Inicia, muda a taxa ou para (hz = 0). false se a taxa estiver fora da faixa,
+// se não houver alarme de hardware livre ou se o perfilador não estiver no build.
+bool profiler_start(uint32_t hz);
+
+// Envia as amostras pendentes enquanto houver espaço na telemetria.
+// Chamado no tempo ocioso, antes de telemetry_poll.
+void profiler_poll(void);
+
+void profiler_get_stats(profiler_stats_t *stats);
+
+#endif // PROFILER_H
@@ -0,0 +1,58 @@
+#include "remote.h"
+#include "pico/stdlib.h"
+#include "telemetry.h"
+
+static uint8_t remote_buf[REMOTE_PACKET_BYTES];
+static uint8_t remote_len = 0;
+static remote_stats_t remote_stats;
+
+// CRC-8, polinômio 0x07 (o mesmo de telemetry.c), bit a bit: são só dois bytes
+static uint8_t remote_crc8(const uint8_t *data, uint8_t len) {
+    uint8_t crc = 0;
+    for (uint8_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (uint8_t bit = 0; bit < 8; bit++)
+            crc = (crc & 0x80) ? (uint8_t)(crc << 1) ^ 0x07 : (uint8_t)(crc << 1);
+    }
+    return crc;
+}
+
+remote_byte_t remote_feed(uint8_t byte, remote_packet_t *packet) {
+    if (remote_len == 0) {
+        if (byte != REMOTE_SYNC)
+            return REMOTE_BYTE_TEXT;
+        remote_buf[remote_len++] = byte;
+        return REMOTE_BYTE_CONSUMED;
+    }
+    remote_buf[remote_len++] = byte;
+    if (remote_len < REMOTE_PACKET_BYTES)
+        return REMOTE_BYTE_CONSUMED;
+
+    remote_len = 0;
+    uint8_t dir = remote_buf[1] & 0x0F;
+    if (remote_crc8(&remote_buf[1], 2) != remote_buf[3] || (dir > 3 && dir != REMOTE_DIR_NONE)) {
+        remote_stats.bad_crc++;
+        return REMOTE_BYTE_CONSUMED;
+    }
+    packet->dir = dir;
+    packet->buttons = remote_buf[1] & 0xF0;
+    packet->seq = remote_buf[2];
+    remote_stats.packets++;
+    return REMOTE_BYTE_PACKET;
+}
+
+void remote_ack(uint8_t seq, remote_result_t result, uint32_t rx_us) {
+    uint32_t latency = time_us_32() - rx_us;
+    if (result == REMOTE_APPLIED) {
+        remote_stats.last_latency_us = latency;
+        if (latency > remote_stats.max_latency_us)
+            remote_stats.max_latency_us = latency;
+    }
+    uint8_t data[6] = {seq, (uint8_t)result, latency & 0xFF, (latency >> 8) & 0xFF,
+                       (latency >> 16) & 0xFF, (latency >> 24) & 0xFF};
+    telemetry_event(TLM_EVENT_REMOTE, data, sizeof(data));
+}
+
+void remote_get_stats(remote_stats_t *stats) {
+    *stats = remote_stats;
+}
@@ -0,0 +1,61 @@
+#ifndef REMOTE_H
+#define REMOTE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Controle remoto pela serial/USB CDC, para bancadas de teste: pacotes binários
+// de direção e botões chegam misturados ao texto do console e entram nas mesmas
+// filas do joystick (curvas) e dos botões de GPIO (eventos da ui), com a mesma
+// prioridade. tools/pad_send.py envia roteiros de entradas e mede a latência.
+//
+// Pacote: [SYNC][botões << 4 | direção][seq u8][crc8]
+// O CRC-8 (polinômio 0x07, o mesmo da telemetria) cobre os dois bytes do meio.
+// O SYNC não é ASCII, então não se confunde com comandos digitados.
+
+#define REMOTE_SYNC 0xC5
+#define REMOTE_PACKET_BYTES 4
+
+#define REMOTE_DIR_NONE 0x0F   // Só botões; 0..3 seguem o enum Direction
+#define REMOTE_BTN_A    0x10   // Pausa
+#define REMOTE_BTN_B    0x20   // Som
+#define REMOTE_BTN_JOY  0x40   // Botão do joystick
+
+// Resultado informado ao host no evento de telemetria TLM_EVENT_REMOTE
+typedef enum {
+    REMOTE_APPLIED = 0,        // Curva aplicada num tick / botão tratado
+    REMOTE_REJECTED,           // Repetição ou reversão da última curva
+    REMOTE_DROPPED,            // Fila de curvas cheia ou entrada desligada (pausa, telas)
+    REMOTE_FLUSHED,            // Ainda na fila quando ela foi esvaziada (novo jogo, nível)
+} remote_result_t;
+
+typedef enum {
+    REMOTE_BYTE_TEXT = 0,      // Não faz parte de um pacote: segue para o console
+    REMOTE_BYTE_CONSUMED,      // Parte de um pacote ainda incompleto (ou inválido)
+    REMOTE_BYTE_PACKET,        // Completou um pacote válido
+} remote_byte_t;
+
+typedef struct {
+    uint8_t dir;               // 0..3 ou REMOTE_DIR_NONE
+    uint8_t buttons;           // REMOTE_BTN_*
+    uint8_t seq;
+} remote_packet_t;
+
+typedef struct {
+    uint32_t packets;
+    uint32_t bad_crc;
+    uint32_t last_latency_us;  // Da chegada do pacote até o tick que o aplicou
+    uint32_t max_latency_us;
+} remote_stats_t;
+
+// Passa um byte recebido pelo decodificador. Em REMOTE_BYTE_PACKET, 'packet'
+// recebe o pacote completo.
+remote_byte_t remote_feed(uint8_t byte, remote_packet_t *packet);
+
+// Confirma um pacote para o host (evento de telemetria) e atualiza a latência.
+// 'rx_us' é o instante de chegada. Chamar do laço principal.
+void remote_ack(uint8_t seq, remote_result_t result, uint32_t rx_us);
+
+void remote_get_stats(remote_stats_t *stats);
+
+#endif // REMOTE_H
@@ -0,0 +1,234 @@
+#include "snapshot.h"
+#include <string.h>
+#include "pico/stdlib.h"
+#include "pico/flash.h"
+#include "hardware/flash.h"
+#include "levels.h"
+#include "logger.h"
+
+// Penúltimo setor da flash (o último guarda config.c)
+#define SNAPSHOT_FLASH_OFFSET (PICO_FLASH_SIZE_BYTES - 2 * FLASH_SECTOR_SIZE)
+#define SNAPSHOT_FLASH_TIMEOUT_MS 100
+#define SNAPSHOT_HEADER_BYTES 8
+
+_Static_assert(SNAPSHOT_MAX_BYTES <= FLASH_PAGE_SIZE && SNAPSHOT_MAX_BYTES <= 255,
+               "o retrato precisa caber numa página e no campo de tamanho");
+
+static snapshot_stats_t snapshot_stats;
+
+// FNV-1a de 32 bits (mesma soma de config.c)
+static uint32_t snapshot_checksum(const uint8_t *data, size_t len) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < len; i++) {
+        hash ^= data[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static inline void snapshot_put_u32(uint8_t *p, uint32_t v) {
+    p[0] = v & 0xFF;
+    p[1] = (v >> 8) & 0xFF;
+    p[2] = (v >> 16) & 0xFF;
+    p[3] = (v >> 24) & 0xFF;
+}
+
+static inline uint32_t snapshot_get_u32(const uint8_t *p) {
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+// Direção de 'a' para o segmento vizinho 'b' (com wrap-around)
+static uint8_t snapshot_delta(Position a, Position b) {
+    if (b.x == (a.x + 1) % WORLD_COLS && b.y == a.y) return RIGHT;
+    if (b.y == (a.y + 1) % WORLD_ROWS && b.x == a.x) return DOWN;
+    if (a.x == (b.x + 1) % WORLD_COLS && b.y == a.y) return LEFT;
+    return UP;
+}
+
+static Position snapshot_step(Position pos, uint8_t dir) {
+    if (dir == RIGHT)
+        pos.x = (pos.x + 1) % WORLD_COLS;
+    else if (dir == DOWN)
+        pos.y = (pos.y + 1) % WORLD_ROWS;
+    else if (dir == LEFT)
+        pos.x = (pos.x + WORLD_COLS - 1) % WORLD_COLS;
+    else
+        pos.y = (pos.y + WORLD_ROWS - 1) % WORLD_ROWS;
+    return pos;
+}
+
+size_t snapshot_encode(const SnakeGame *game, uint8_t *buf) {
+    uint8_t *p = buf + SNAPSHOT_HEADER_BYTES;
+    *p++ = game->num_snakes;
+    *p++ = game->level_index;
+    *p++ = game->level_eaten;
+    *p++ = game->food.x;
+    *p++ = game->food.y;
+
+    for (uint8_t id = 0; id < game->num_snakes; id++) {
+        const Snake *snake = &game->snakes[id];
+        uint8_t length = snake->alive ? snake->length : 0;
+        Position head = snake_head(snake);
+        *p++ = snake->alive;
+        *p++ = (uint8_t)snake->control;
+        *p++ = (uint8_t)snake->direction;
+        *p++ = snake->score & 0xFF;
+        *p++ = (snake->score >> 8) & 0xFF;
+        *p++ = length;
+        *p++ = head.x;
+        *p++ = head.y;
+        // 2 bits por segmento, do segmento i para o i + 1
+        uint8_t packed = 0;
+        for (uint8_t i = 0; i + 1 < length; i++) {
+            packed |= snapshot_delta(snake_segment(snake, i), snake_segment(snake, i + 1)) << ((i & 3) * 2);
+            if ((i & 3) == 3 || i + 2 == length) {
+                *p++ = packed;
+                packed = 0;
+            }
+        }
+    }
+
+    size_t len = (size_t)(p - buf) + 4;
+    snapshot_put_u32(buf, SNAPSHOT_MAGIC);
+    buf[4] = SNAPSHOT_VERSION;
+    buf[5] = (uint8_t)len;
+    buf[6] = WORLD_COLS - 1;
+    buf[7] = WORLD_ROWS - 1;
+    snapshot_put_u32(p, snapshot_checksum(buf, len - 4));
+    return len;
+}
+
+// Percorre o retrato; com game = NULL só valida, sem gravar nada
+static bool snapshot_parse(SnakeGame *game, const uint8_t *buf, size_t len) {
+    if (len < SNAPSHOT_HEADER_BYTES + 5 + 4 || len > SNAPSHOT_MAX_BYTES)
+        return false;
+    if (snapshot_get_u32(buf) != SNAPSHOT_MAGIC || buf[4] != SNAPSHOT_VERSION || buf[5] != len ||
+        buf[6] != WORLD_COLS - 1 || buf[7] != WORLD_ROWS - 1)
+        return false;
+    if (snapshot_get_u32(buf + len - 4) != snapshot_checksum(buf, len - 4))
+        return false;
+
+    const uint8_t *p = buf + SNAPSHOT_HEADER_BYTES;
+    const uint8_t *end = buf + len - 4;
+    uint8_t num_snakes = p[0];
+    uint8_t level = p[1];
+    if (num_snakes < 1 || num_snakes > SNAKE_MAX_PLAYERS || level >= LEVEL_COUNT ||
+        p[3] >= WORLD_COLS || p[4] >= WORLD_ROWS)
+        return false;
+    if (game) {
+        game->num_snakes = num_snakes;
+        game->level_index = level;
+        game->level = &levels[level];
+        game->level_eaten = p[2];
+        game->level_complete = false;
+        game->food.x = p[3];
+        game->food.y = p[4];
+        game->stepped = false;
+        game->game_over_flag = false;
+        game->winner = -1;
+        world_clear(&game->world);
+    }
+    p += 5;
+
+    for (uint8_t id = 0; id < num_snakes; id++) {
+        if (end - p < 8)
+            return false;
+        uint8_t length = p[5];
+        if (p[1] > SNAKE_CTRL_AUTOPILOT || p[2] > UP || length > MAX_SNAKE_LENGTH ||
+            (p[0] && length == 0) || p[6] >= WORLD_COLS || p[7] >= WORLD_ROWS)
+            return false;
+        size_t delta_bytes = length > 1 ? (length - 1 + 3) / 4 : 0;
+        if ((size_t)(end - p) < 8 + delta_bytes)
+            return false;
+
+        if (game) {
+            Snake *snake = &game->snakes[id];
+            snake->alive = p[0] != 0;
+            snake->control = (SnakeControl)p[1];
+            snake->direction = (Direction)p[2];
+            snake->next_direction = snake->direction;
+            snake->score = p[3] | (p[4] << 8);
+            snake->length = length;
+            snake->head = 0;
+            Position pos = {p[6], p[7]};
+            for (uint8_t i = 0; i < length; i++) {
+                snake->body[i] = pos;
+                world_set(&game->world, pos.x, pos.y, id + 1);
+                if (i + 1 < length)
+                    pos = snapshot_step(pos, (p[8 + i / 4] >> ((i & 3) * 2)) & 3);
+            }
+            snake->tail_prev = pos;
+        }
+        p += 8 + delta_bytes;
+    }
+    if (game) {
+        // Cobras além das gravadas ficam fora do jogo
+        for (uint8_t id = num_snakes; id < SNAKE_MAX_PLAYERS; id++)
+            game->snakes[id].alive = false;
+    }
+    return p == end;
+}
+
+bool snapshot_decode(SnakeGame *game, const uint8_t *buf, size_t len) {
+    if (!snapshot_parse(NULL, buf, len))
+        return false;
+    return snapshot_parse(game, buf, len);
+}
+
+// Roda com as interrupções desligadas por flash_safe_execute
+static void snapshot_flash_write(void *param) {
+    flash_range_erase(SNAPSHOT_FLASH_OFFSET, FLASH_SECTOR_SIZE);
+    flash_range_program(SNAPSHOT_FLASH_OFFSET, (const uint8_t *)param, FLASH_PAGE_SIZE);
+}
+
+// Zera a página sem apagar o setor: programar só derruba bits, então o
+// magic deixa de bater em uma programação de página (bem mais rápida que o
+// apagamento, que fica para o próximo snapshot_save)
+static void snapshot_flash_invalidate(void *param) {
+    static const uint8_t zeros[FLASH_PAGE_SIZE];
+    flash_range_program(SNAPSHOT_FLASH_OFFSET, zeros, FLASH_PAGE_SIZE);
+}
+
+bool snapshot_save(const SnakeGame *game) {
+    static uint8_t page[FLASH_PAGE_SIZE];
+    uint32_t t0 = time_us_32();
+    memset(page, 0xFF, sizeof(page));
+    size_t len = snapshot_encode(game, page);
+    uint32_t t1 = time_us_32();
+    int rc = flash_safe_execute(snapshot_flash_write, page, SNAPSHOT_FLASH_TIMEOUT_MS);
+    uint32_t t2 = time_us_32();
+    if (rc != PICO_OK) {
+        LOG_ERROR("snapshot: falha ao gravar na flash (%d)\n", rc);
+        return false;
+    }
+    snapshot_stats.saves++;
+    snapshot_stats.bytes = len;
+    snapshot_stats.encode_us = t1 - t0;
+    snapshot_stats.save_us = t2 - t0;
+    LOG_INFO("snapshot: %lu bytes gravados em %lu us\n", snapshot_stats.bytes, snapshot_stats.save_us);
+    return true;
+}
+
+bool snapshot_restore(SnakeGame *game) {
+    uint32_t t0 = time_us_32();
+    // Leitura direta pela XIP; o tamanho vem do cabeçalho e é conferido na validação
+    const uint8_t *saved = (const uint8_t *)(XIP_BASE + SNAPSHOT_FLASH_OFFSET);
+    if (!snapshot_decode(game, saved, saved[5]))
+        return false;
+    snapshot_stats.restores++;
+    snapshot_stats.bytes = saved[5];
+    snapshot_stats.restore_us = time_us_32() - t0;
+    LOG_INFO("snapshot: jogo restaurado em %lu us\n", snapshot_stats.restore_us);
+    return true;
+}
+
+void snapshot_discard(void) {
+    const uint8_t *saved = (const uint8_t *)(XIP_BASE + SNAPSHOT_FLASH_OFFSET);
+    if (snapshot_get_u32(saved) != SNAPSHOT_MAGIC)
+        return;  // Já invalidado: evita desgastar o setor
+    flash_safe_execute(snapshot_flash_invalidate, NULL, SNAPSHOT_FLASH_TIMEOUT_MS);
+}
+
+const snapshot_stats_t *snapshot_get_stats(void) {
+    return &snapshot_stats;
+}
@@ -0,0 +1,53 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "snake.h"
+
+// Retrato compacto e versionado do SnakeGame, gravado na flash quando o jogo é
+// pausado e restaurado no boot. O corpo de cada cobra vira a posição da cabeça
+// mais 2 bits por segmento (direção do segmento até o seguinte), então uma
+// cobra de 128 segmentos ocupa 40 bytes.
+//
+// Formato (little-endian):
+//   [magic u32][versão u8][tamanho u8][colunas u8][linhas u8]
+//   [cobras u8][nível u8][comidas no nível u8][comida x u8, y u8]
+//   por cobra: [viva u8][controle u8][direção u8][pontuação u16][comprimento u8]
+//              [cabeça x u8, y u8][deltas: 4 por byte, o 1º nos bits baixos]
+//   [FNV-1a u32 de tudo o que vem antes]
+
+#define SNAPSHOT_MAGIC 0x534E4B53u   // "SNKS"
+#define SNAPSHOT_VERSION 1
+#define SNAPSHOT_SNAKE_BYTES (8 + (MAX_SNAKE_LENGTH + 3) / 4)
+#define SNAPSHOT_MAX_BYTES (4 + 4 + 5 + SNAKE_MAX_PLAYERS * SNAPSHOT_SNAKE_BYTES + 4)
+
+typedef struct {
+    uint32_t saves;
+    uint32_t restores;
+    uint32_t bytes;          // Tamanho do último retrato
+    uint32_t encode_us;      // Serialização
+    uint32_t save_us;        // Serialização + gravação na flash
+    uint32_t restore_us;     // Leitura, verificação e reconstrução da grade
+} snapshot_stats_t;
+
+// Serializa em 'buf' (pelo menos SNAPSHOT_MAX_BYTES). Retorna o tamanho.
+size_t snapshot_encode(const SnakeGame *game, uint8_t *buf);
+
+// Reconstrói o jogo (cobras, grade, nível e comida). Retorna false se o retrato
+// for inválido ou de outra versão/tamanho de mundo; o jogo não é alterado.
+bool snapshot_decode(SnakeGame *game, const uint8_t *buf, size_t len);
+
+// Grava o retrato na flash (penúltimo setor; o último é de config.c).
+bool snapshot_save(const SnakeGame *game);
+
+// Restaura o retrato gravado, lendo direto da flash. false se não houver um válido.
+bool snapshot_restore(SnakeGame *game);
+
+// Invalida o retrato (jogo retomado ou fim de jogo), só se houver um gravado.
+void snapshot_discard(void);
+
+const snapshot_stats_t *snapshot_get_stats(void);
+
+#endif // SNAPSHOT_H
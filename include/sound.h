@@ -5,6 +5,7 @@
 #include "pico/stdlib.h"
 #include "hardware/pwm.h"
 #include "hardware/clocks.h"
+#include "audio.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -19,15 +20,11 @@ extern "C" {
 #define BUZZER_EXP 21  // Buzzer para som de explosão
 #endif
 
-// Estrutura para representar uma nota (frequência e duração)
-typedef struct {
-    uint32_t frequency;
-    uint32_t duration_ms;
-} note_t;
-
 // Protótipos das funções da biblioteca de som
-void play_tone(uint gpio, uint32_t frequency, uint32_t duration_ms);
-void sound_play_background_note(void);
+void sound_init(void);
+// Liga/desliga a música de fundo em loop; pode ser chamada a cada quadro
+void sound_set_background_enabled(bool enabled);
+// Dispara a explosão por cima da música e retorna imediatamente
 void sound_play_explosion_sound(void);
 
 #ifdef __cplusplus
@@ -6,8 +6,53 @@
 #include "pico/stdlib.h"
 #include "hardware/i2c.h"
 
-#define WIDTH 128
-#define HEIGHT 64
+// Geometria do painel fixada na compilação (CMake: -DSNAKE_OLED_HEIGHT=32 para
+// módulos 128x32). Com ela o framebuffer é um array estático do tamanho exato e
+// as contas de índice de ssd1306_pixel e dos blits usam constantes.
+// SSD1306_RUNTIME_GEOMETRY=1 volta a ler largura/altura da struct (qualquer
+// painel passado a ssd1306_init).
+#ifndef SSD1306_WIDTH
+#define SSD1306_WIDTH 128
+#endif
+#ifndef SSD1306_HEIGHT
+#define SSD1306_HEIGHT 64
+#endif
+#ifndef SSD1306_RUNTIME_GEOMETRY
+#define SSD1306_RUNTIME_GEOMETRY 0
+#endif
+
+#if SSD1306_HEIGHT != 64 && SSD1306_HEIGHT != 32
+#error "SSD1306_HEIGHT deve ser 64 ou 32"
+#endif
+
+#define WIDTH SSD1306_WIDTH
+#define HEIGHT SSD1306_HEIGHT
+#define SSD1306_PAGES (SSD1306_HEIGHT / 8)
+
+// Build sem heap (CMake: -DSNAKE_STATIC_ALLOC=ON): o framebuffer é um array
+// estático dimensionado para WIDTH x HEIGHT, e só um display pode ser iniciado.
+// Com a geometria fixa isso vale sempre.
+#ifndef SNAKE_NO_HEAP
+#define SNAKE_NO_HEAP 0
+#endif
+#define SSD1306_STATIC_BUFSIZE (SSD1306_WIDTH * SSD1306_PAGES + 1)
+
+#define SSD1306_MAX_COMMANDS 32   // Comandos por transação em ssd1306_command_list (mais = panic)
+
+// Dimensões usadas pelo desenho: constantes na geometria fixa
+#if SSD1306_RUNTIME_GEOMETRY
+#define SSD1306_COLS(ssd) ((ssd)->width)
+#define SSD1306_ROWS(ssd) ((ssd)->height)
+#define SSD1306_NPAGES(ssd) ((ssd)->pages)
+#else
+#define SSD1306_COLS(ssd) SSD1306_WIDTH
+#define SSD1306_ROWS(ssd) SSD1306_HEIGHT
+#define SSD1306_NPAGES(ssd) SSD1306_PAGES
+#endif
+
+// Posição y das telas de texto, escrita para 64 linhas e comprimida nos
+// painéis de 32
+#define SSD1306_SCALE_Y(y) ((y) * SSD1306_HEIGHT / 64)
 
 typedef enum {
   SET_CONTRAST = 0x81,
@@ -29,21 +74,43 @@ typedef enum {
   SET_CHARGE_PUMP = 0x8D
 } ssd1306_command_t;
 
-typedef struct {
+typedef struct ssd1306 {
   uint8_t width, height, pages, address;
   i2c_inst_t *i2c_port;
   bool external_vcc;
   uint8_t *ram_buffer;
   size_t bufsize;
   uint8_t port_buffer[2];
+  void (*send_hook)(const struct ssd1306 *ssd); // Chamado após cada ssd1306_send_data (opcional)
+  uint8_t *shadow;                               // Cópia do que o painel recebeu (sem o byte de controle)
+  bool shadow_valid;                             // false força o envio de todas as páginas
+  uint32_t pages_sent, pages_skipped;
+  uint32_t bytes_sent;                           // Bytes de dados enviados pelo I2C
 } ssd1306_t;
 
 void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c);
 void ssd1306_config(ssd1306_t *ssd);
 void ssd1306_command(ssd1306_t *ssd, uint8_t command);
+void ssd1306_command_list(ssd1306_t *ssd, const uint8_t *commands, size_t count);
 void ssd1306_send_data(ssd1306_t *ssd);
+void ssd1306_invalidate(ssd1306_t *ssd);
+uint32_t ssd1306_frame_hash(const ssd1306_t *ssd);
 
+#if SSD1306_RUNTIME_GEOMETRY
 void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value);
+#else
+// Inline: com largura e páginas constantes o índice vira um shift e uma soma
+static inline void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value) {
+  if (x >= SSD1306_WIDTH || y >= SSD1306_HEIGHT)
+    return;
+  uint16_t index = 1 + x + (y / 8) * SSD1306_WIDTH;
+  uint8_t bit = 1 << (y % 8);
+  if (value)
+    ssd->ram_buffer[index] |= bit;
+  else
+    ssd->ram_buffer[index] &= ~bit;
+}
+#endif
 void ssd1306_fill(ssd1306_t *ssd, bool value);
 void ssd1306_rect(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value, bool fill);
 void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, bool value);
@@ -51,7 +118,9 @@ void ssd1306_hline(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t y, bool value
 void ssd1306_vline(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value);
 void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y);
 void ssd1306_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y);
-void ssd1306_draw_bitmap(ssd1306_t *ssd, uint8_t x, uint8_t y, const uint8_t *bitmap);
+// Bitmap 8x8 em qualquer posição de pixel, recortado nas bordas (x e y podem
+// ser negativos); substitui o que havia dentro do quadrado 8x8
+void ssd1306_draw_bitmap(ssd1306_t *ssd, int16_t x, int16_t y, const uint8_t *bitmap);
 void draw_border(ssd1306_t *ssd, uint8_t style);
 
 #endif // SSD1306_H
\ No newline at end of file
@@ -0,0 +1,203 @@
+#include "telemetry.h"
+#include <string.h>
+#include "pico/stdlib.h"
+
+#if LIB_PICO_STDIO_USB
+#include "pico/stdio_usb.h"
+#include "tusb.h"
+#endif
+
+#define TELEMETRY_MASK (TELEMETRY_BUFFER_SIZE - 1)
+
+// Buffer circular de produtor único / consumidor único: o produtor só avança
+// 'head' e o consumidor só avança 'tail', então nenhum dos dois precisa de trava.
+static uint8_t telemetry_buffer[TELEMETRY_BUFFER_SIZE];
+static volatile uint32_t telemetry_head = 0;
+static volatile uint32_t telemetry_tail = 0;
+static uint32_t telemetry_dropped = 0;
+
+static uint16_t telemetry_tick_count = 0;
+
+// Último estado enviado, para transmitir apenas os campos que mudaram
+static struct {
+    Position head;
+    Direction dir;
+    uint8_t length;
+    int score;
+    Position food;
+    bool valid;
+} telemetry_last;
+
+// CRC-8 (polinômio 0x07) com tabela de 16 entradas, processada por nibble
+static const uint8_t telemetry_crc_table[16] = {
+    0x00, 0x07, 0x0E, 0x09, 0x1C, 0x1B, 0x12, 0x15,
+    0x38, 0x3F, 0x36, 0x31, 0x24, 0x23, 0x2A, 0x2D
+};
+
+static inline uint8_t telemetry_crc8(uint8_t crc, uint8_t byte) {
+    crc ^= byte;
+    crc = (uint8_t)(crc << 4) ^ telemetry_crc_table[crc >> 4];
+    crc = (uint8_t)(crc << 4) ^ telemetry_crc_table[crc >> 4];
+    return crc;
+}
+
+static inline void telemetry_put(uint32_t pos, uint8_t byte) {
+    telemetry_buffer[pos & TELEMETRY_MASK] = byte;
+}
+
+void telemetry_init(void) {
+    telemetry_head = 0;
+    telemetry_tail = 0;
+    telemetry_dropped = 0;
+    telemetry_tick_count = 0;
+    telemetry_last.valid = false;
+}
+
+bool telemetry_send(uint8_t type, const uint8_t *payload, uint8_t len) {
+    uint32_t head = telemetry_head;
+    uint32_t frame_len = 4u + len;
+    if (TELEMETRY_BUFFER_SIZE - (head - telemetry_tail) < frame_len) {
+        telemetry_dropped++;
+        return false;
+    }
+
+    uint8_t crc = telemetry_crc8(telemetry_crc8(0, type), len);
+    telemetry_put(head++, TELEMETRY_SYNC);
+    telemetry_put(head++, type);
+    telemetry_put(head++, len);
+    for (uint8_t i = 0; i < len; i++) {
+        telemetry_put(head++, payload[i]);
+        crc = telemetry_crc8(crc, payload[i]);
+    }
+    telemetry_put(head++, crc);
+
+    // Publica o quadro só depois que todos os bytes estão no buffer
+    __dmb();
+    telemetry_head = head;
+    return true;
+}
+
+// O tick descreve a cobra do jogador 1; as demais só aparecem nos eventos
+void telemetry_tick(const SnakeGame *game) {
+    const Snake *snake = &game->snakes[0];
+    uint8_t payload[12];
+    uint8_t len = 3;
+    uint8_t mask = 0;
+
+    telemetry_tick_count++;
+    payload[0] = telemetry_tick_count & 0xFF;
+    payload[1] = telemetry_tick_count >> 8;
+
+    bool full = !telemetry_last.valid;
+    Position head = snake_head(snake);
+    if (full || head.x != telemetry_last.head.x || head.y != telemetry_last.head.y) {
+        mask |= TLM_TICK_HEAD;
+        payload[len++] = (uint8_t)head.x;
+        payload[len++] = (uint8_t)head.y;
+    }
+    if (full || snake->direction != telemetry_last.dir) {
+        mask |= TLM_TICK_DIR;
+        payload[len++] = (uint8_t)snake->direction;
+    }
+    if (full || snake->length != telemetry_last.length) {
+        mask |= TLM_TICK_LENGTH;
+        payload[len++] = snake->length;
+    }
+    if (full || snake->score != telemetry_last.score) {
+        mask |= TLM_TICK_SCORE;
+        payload[len++] = snake->score & 0xFF;
+        payload[len++] = (snake->score >> 8) & 0xFF;
+    }
+    if (full || game->food.x != telemetry_last.food.x || game->food.y != telemetry_last.food.y) {
+        mask |= TLM_TICK_FOOD;
+        payload[len++] = (uint8_t)game->food.x;
+        payload[len++] = (uint8_t)game->food.y;
+    }
+    payload[2] = mask;
+
+    // Se o quadro for descartado, o próximo leva o estado completo
+    telemetry_last.valid = telemetry_send(TLM_FRAME_TICK, payload, len);
+    telemetry_last.head = head;
+    telemetry_last.dir = snake->direction;
+    telemetry_last.length = snake->length;
+    telemetry_last.score = snake->score;
+    telemetry_last.food = game->food;
+}
+
+void telemetry_event(telemetry_event_t event, const uint8_t *data, uint8_t len) {
+    uint8_t payload[16];
+    if (len > sizeof(payload) - 3)
+        len = sizeof(payload) - 3;
+    payload[0] = telemetry_tick_count & 0xFF;
+    payload[1] = telemetry_tick_count >> 8;
+    payload[2] = (uint8_t)event;
+    if (len)
+        memcpy(&payload[3], data, len);
+    telemetry_send(TLM_FRAME_EVENT, payload, len + 3);
+    if (event == TLM_EVENT_RESET)
+        telemetry_last.valid = false;
+}
+
+void telemetry_timing(const uint32_t *stage_us, uint8_t count) {
+    uint8_t payload[3 + 2 * TLM_STAGE_COUNT];
+    if (count > TLM_STAGE_COUNT)
+        count = TLM_STAGE_COUNT;
+    payload[0] = telemetry_tick_count & 0xFF;
+    payload[1] = telemetry_tick_count >> 8;
+    payload[2] = count;
+    for (uint8_t i = 0; i < count; i++) {
+        uint32_t us = stage_us[i] > 0xFFFF ? 0xFFFF : stage_us[i];
+        payload[3 + 2 * i] = us & 0xFF;
+        payload[4 + 2 * i] = us >> 8;
+    }
+    telemetry_send(TLM_FRAME_TIMING, payload, 3 + 2 * count);
+}
+
+void telemetry_poll(void) {
+#if LIB_PICO_STDIO_USB
+    uint32_t tail = telemetry_tail;
+    uint32_t pending = telemetry_head - tail;
+    if (pending == 0)
+        return;
+
+    // Sem host conectado, descarta: ao conectar, o host recebe dados recentes
+    if (!stdio_usb_connected()) {
+        telemetry_tail = telemetry_head;
+        return;
+    }
+
+    // Só quadros inteiros e só o que cabe no FIFO do CDC: out_chars nunca
+    // espera, e o printf do log e do console que vem depois não cai no meio
+    // de um quadro (o host o descartaria pelo CRC)
+    uint32_t avail = tud_cdc_write_available();
+    uint32_t n = 0;
+    while (n < pending) {
+        uint32_t frame_len = 4u + telemetry_buffer[(tail + n + 2) & TELEMETRY_MASK];
+        // Um quadro maior que o FIFO inteiro só sai com o FIFO vazio
+        bool oversized = n == 0 && frame_len > CFG_TUD_CDC_TX_BUFSIZE && avail == CFG_TUD_CDC_TX_BUFSIZE;
+        if (n + frame_len > avail && !oversized)
+            break;
+        n += frame_len;
+    }
+    if (n == 0)
+        return;
+
+    // Na volta do buffer circular o trecho sai em duas escritas seguidas
+    uint32_t contiguous = TELEMETRY_BUFFER_SIZE - (tail & TELEMETRY_MASK);
+    uint32_t first = n < contiguous ? n : contiguous;
+    stdio_usb.out_chars((const char *)&telemetry_buffer[tail & TELEMETRY_MASK], (int)first);
+    if (n > first)
+        stdio_usb.out_chars((const char *)telemetry_buffer, (int)(n - first));
+    telemetry_tail = tail + n;
+#else
+    telemetry_tail = telemetry_head;
+#endif
+}
+
+uint32_t telemetry_free(void) {
+    return TELEMETRY_BUFFER_SIZE - (telemetry_head - telemetry_tail);
+}
+
+uint32_t telemetry_get_dropped(void) {
+    return telemetry_dropped;
+}
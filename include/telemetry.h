@@ -0,0 +1,68 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "snake.h"
+
+// Buffer circular de saída (precisa ser potência de 2)
+#define TELEMETRY_BUFFER_SIZE 2048
+
+// Formato do quadro: [SYNC][tipo][tamanho][payload...][crc8]
+// O CRC-8 (polinômio 0x07) cobre tipo, tamanho e payload.
+#define TELEMETRY_SYNC 0xA5
+#define TELEMETRY_MAX_PAYLOAD 255
+
+typedef enum {
+    TLM_FRAME_TICK   = 0x01,  // [tick u16][máscara u8][campos alterados...]
+    TLM_FRAME_EVENT  = 0x02,  // [tick u16][evento u8][dados...]
+    TLM_FRAME_TIMING = 0x03,  // [tick u16][n u8][n x duração u16 em µs]
+    TLM_FRAME_FB_PAGE = 0x04, // ver fbstream.h
+    TLM_FRAME_FB_END  = 0x05, // ver fbstream.h
+    TLM_FRAME_PROFILE = 0x06, // ver profiler.h
+} telemetry_frame_t;
+
+// Campos do quadro de tick, na ordem em que aparecem quando presentes
+#define TLM_TICK_HEAD   0x01  // x u8, y u8
+#define TLM_TICK_DIR    0x02  // direção u8
+#define TLM_TICK_LENGTH 0x04  // comprimento u8
+#define TLM_TICK_SCORE  0x08  // pontuação u16
+#define TLM_TICK_FOOD   0x10  // x u8, y u8
+
+typedef enum {
+    TLM_EVENT_FOOD  = 1,  // x u8, y u8
+    TLM_EVENT_DEATH = 2,  // pontuação u16, comprimento u8
+    TLM_EVENT_SCORE = 3,  // pontuação u16
+    TLM_EVENT_RESET = 4,  // sem dados
+    TLM_EVENT_OVERRUN = 5,   // estágio u8, atraso u32 em µs (deadline.h)
+    TLM_EVENT_WATCHDOG = 6,  // estágio u8, quadro u16 em que o watchdog resetou
+    TLM_EVENT_REMOTE = 7,    // seq u8, resultado u8, latência u32 em µs (remote.h)
+} telemetry_event_t;
+
+// Estágios medidos no quadro de tempo
+typedef enum {
+    TLM_STAGE_INPUT = 0,
+    TLM_STAGE_UPDATE,
+    TLM_STAGE_DRAW,
+    TLM_STAGE_AUDIO,
+    TLM_STAGE_COUNT
+} telemetry_stage_t;
+
+void telemetry_init(void);
+
+// Produtores: só copiam bytes para o buffer; o quadro é descartado se não couber.
+// Devem ser chamados do laço principal (um único produtor), nunca de interrupções.
+bool telemetry_send(uint8_t type, const uint8_t *payload, uint8_t len);
+void telemetry_tick(const SnakeGame *game);
+void telemetry_event(telemetry_event_t event, const uint8_t *data, uint8_t len);
+void telemetry_timing(const uint32_t *stage_us, uint8_t count);
+
+// Envia o que couber no FIFO do USB CDC sem esperar. Chamado no tempo ocioso.
+void telemetry_poll(void);
+
+// Bytes livres no buffer (um quadro ocupa payload + 4).
+uint32_t telemetry_free(void);
+
+uint32_t telemetry_get_dropped(void);
+
+#endif // TELEMETRY_H
@@ -0,0 +1,466 @@
+#include "ui.h"
+#include <stdio.h>
+#include <string.h>
+#include "hardware/sync.h"
+#include "config.h"
+#include "console.h"
+#include "deadline.h"
+#include "highscore.h"
+#include "input.h"
+#include "levels.h"
+#include "logger.h"
+#include "power.h"
+#include "remote.h"
+#include "snapshot.h"
+#include "sound.h"
+#include "telemetry.h"
+
+static SnakeGame *ui_game;
+static ssd1306_t *ui_display;
+static pio_t *ui_led_matrix;
+
+static ui_state_t ui_state = UI_PLAYING;
+static absolute_time_t ui_next_frame;
+static volatile bool ui_sound_on = true;
+static bool ui_snapshot_saved;              // A flash guarda o retrato desta pausa
+
+// Telas entre os ticks: a lógica anda a cada frame_delay_ms; a tela, com
+// cabeça e cauda interpoladas desde o início do tick, é redesenhada quando a
+// interpolação avança um pixel, no máximo render_fps vezes por segundo
+static absolute_time_t ui_next_render;
+static uint32_t ui_tick_us;
+static uint8_t ui_drawn_step;              // Passo (pixels) da última tela enviada
+static ui_render_stats_t ui_render_stats;
+static uint32_t ui_fps_window_us;
+static uint16_t ui_fps_draws;
+static uint32_t ui_fps_bytes;
+
+// Fila de eventos: escrita nas interrupções (GPIO e serial), lida no laço principal
+static volatile uint8_t ui_events[UI_EVENT_QUEUE_SIZE];
+static volatile uint32_t ui_events_head = 0;
+static volatile uint32_t ui_events_tail = 0;
+static volatile bool ui_chars_pending = false;
+static volatile uint32_t ui_chars_us;      // Chegada dos caracteres ainda não lidos
+static uint32_t ui_last_press_us[3];
+
+// Entrada do nome de um novo recorde
+static char ui_name[UI_NAME_MAX + 1];
+static uint8_t ui_name_len = 0;
+static absolute_time_t ui_name_deadline;
+
+// Fim da tela de troca de nível
+static absolute_time_t ui_level_deadline;
+
+// Duas fontes de interrupção podem produzir; a inserção é feita com as IRQs mascaradas
+static void ui_push_event(ui_event_t event) {
+    uint32_t irq = save_and_disable_interrupts();
+    if (ui_events_head - ui_events_tail < UI_EVENT_QUEUE_SIZE) {
+        ui_events[ui_events_head & (UI_EVENT_QUEUE_SIZE - 1)] = (uint8_t)event;
+        __dmb();
+        ui_events_head++;
+    }
+    restore_interrupts(irq);
+}
+
+static bool ui_pop_event(ui_event_t *event) {
+    if (ui_events_tail == ui_events_head)
+        return false;
+    *event = (ui_event_t)ui_events[ui_events_tail & (UI_EVENT_QUEUE_SIZE - 1)];
+    __dmb();
+    ui_events_tail++;
+    return true;
+}
+
+// Callback de interrupção para os três botões, com debouncing
+static void ui_gpio_callback(uint gpio, uint32_t events) {
+    if (!(events & GPIO_IRQ_EDGE_FALL))
+        return;
+    ui_event_t event;
+    int slot;
+    if (gpio == PAUSE_BTN) {
+        event = UI_EVENT_PAUSE;
+        slot = 0;
+    } else if (gpio == SOUND_BTN) {
+        event = UI_EVENT_SOUND;
+        slot = 1;
+    } else if (gpio == JOYSTICK_BTN) {
+        event = UI_EVENT_JOY_PRESS;
+        slot = 2;
+    } else {
+        return;
+    }
+    uint32_t now = time_us_32();
+    if (now - ui_last_press_us[slot] < UI_DEBOUNCE_US)
+        return;
+    ui_last_press_us[slot] = now;
+    ui_push_event(event);
+}
+
+static void ui_chars_available(void *param) {
+    if (!ui_chars_pending)
+        ui_chars_us = time_us_32();
+    ui_chars_pending = true;
+}
+
+static void ui_button_init(uint gpio) {
+    gpio_init(gpio);
+    gpio_set_dir(gpio, GPIO_IN);
+    gpio_pull_up(gpio);
+    gpio_set_irq_enabled_with_callback(gpio, GPIO_IRQ_EDGE_FALL, true, ui_gpio_callback);
+}
+
+void ui_init(SnakeGame *game, ssd1306_t *display, pio_t *led_matrix) {
+    ui_game = game;
+    ui_display = display;
+    ui_led_matrix = led_matrix;
+
+    ui_button_init(JOYSTICK_BTN);
+    ui_button_init(PAUSE_BTN);
+    ui_button_init(SOUND_BTN);
+    stdio_set_chars_available_callback(ui_chars_available, NULL);
+
+    ui_state = UI_PLAYING;
+    ui_next_frame = get_absolute_time();
+    ui_next_render = at_the_end_of_time;
+}
+
+// -------------------------------------------------------------------
+// Entrada em cada estado (desenho da tela e estado de energia)
+
+static void ui_enter(ui_state_t state) {
+    LOG_DEBUG("ui: %d -> %d\n", ui_state, state);
+    ui_state = state;
+
+    switch (state) {
+    case UI_PLAYING:
+        power_exit();
+        input_set_enabled(true);
+        // Retomado: o retrato ficou velho e não pode voltar num reset futuro
+        if (ui_snapshot_saved) {
+            snapshot_discard();
+            ui_snapshot_saved = false;
+        }
+        ui_next_frame = get_absolute_time();
+        ui_next_render = at_the_end_of_time;
+        break;
+
+    case UI_PAUSED:
+        sound_set_background_enabled(false);
+        input_set_enabled(false);
+        ssd1306_fill(ui_display, 0);
+        ssd1306_draw_string(ui_display, "PAUSE", 44, SSD1306_SCALE_Y(28));
+        ssd1306_send_data(ui_display);
+        // Retrato na flash: uma queda de energia na pausa não perde o jogo
+        // (já está lá quando a pausa vem de um retrato restaurado no boot)
+        if (!ui_snapshot_saved)
+            ui_snapshot_saved = snapshot_save(ui_game);
+        // Clock reduzido até o botão A retomar o jogo
+        power_enter(POWER_STATE_PAUSED);
+        break;
+
+    case UI_GAME_OVER: {
+        input_set_enabled(false);
+        const Snake *p1 = &ui_game->snakes[0];
+        uint8_t death[3] = {p1->score & 0xFF, (p1->score >> 8) & 0xFF, p1->length};
+        telemetry_event(TLM_EVENT_DEATH, death, sizeof(death));
+        sound_set_background_enabled(false);
+        snapshot_discard();
+        if (ui_sound_on)
+            sound_play_explosion_sound();
+        // Tela de Game Over; a animação da matriz segue pelo motor de efeitos
+        snake_game_over_screen(ui_game, ui_display, ui_led_matrix);
+        power_enter(POWER_STATE_WAIT);
+        break;
+    }
+
+    case UI_NAME_ENTRY:
+        ui_name_len = 0;
+        ui_name[0] = '\0';
+        ui_name_deadline = make_timeout_time_ms(UI_NAME_TIMEOUT_MS);
+        high_score_prompt(ui_display);
+        break;
+
+    case UI_SCOREBOARD:
+        display_scoreboard(ui_display);
+        break;
+
+    case UI_LEVEL_UP: {
+        // Mostra o próximo nível; a troca acontece quando a tela some
+        input_set_enabled(false);
+        const level_t *next = &levels[(ui_game->level_index + 1) % LEVEL_COUNT];
+        char title[16];
+        snprintf(title, sizeof(title), "NIVEL %u", (ui_game->level_index + 1) % LEVEL_COUNT + 1);
+        ssd1306_fill(ui_display, 0);
+        ssd1306_draw_string(ui_display, title, 28, SSD1306_SCALE_Y(20));
+        ssd1306_draw_string(ui_display, next->name, 28, SSD1306_SCALE_Y(36));
+        ssd1306_send_data(ui_display);
+        ui_level_deadline = make_timeout_time_ms(UI_LEVEL_UP_MS);
+        break;
+    }
+
+    default:
+        break;
+    }
+}
+
+static void ui_finish_name_entry(void) {
+    high_score_insert(ui_game->snakes[0].score, ui_name_len ? ui_name : "Anonimo");
+    ui_enter(UI_SCOREBOARD);
+}
+
+// -------------------------------------------------------------------
+// Eventos
+
+static void ui_handle_event(ui_event_t event) {
+    if (event == UI_EVENT_SOUND) {
+        ui_sound_on = !ui_sound_on;
+        return;
+    }
+
+    switch (ui_state) {
+    case UI_PLAYING:
+        if (event == UI_EVENT_PAUSE)
+            ui_enter(UI_PAUSED);
+        break;
+    case UI_PAUSED:
+        if (event == UI_EVENT_PAUSE)
+            ui_enter(UI_PLAYING);
+        break;
+    case UI_GAME_OVER:
+        if (event == UI_EVENT_JOY_PRESS)
+            ui_enter(high_score_qualifies(ui_game->snakes[0].score) ? UI_NAME_ENTRY : UI_SCOREBOARD);
+        break;
+    case UI_SCOREBOARD:
+        if (event == UI_EVENT_JOY_PRESS) {
+            // Reinicia o jogo do primeiro nível
+            snake_set_level(ui_game, 0);
+            snake_init(ui_game);
+            telemetry_event(TLM_EVENT_RESET, NULL, 0);
+            ui_enter(UI_PLAYING);
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+// Pacote do controle remoto: os botões viram os mesmos eventos dos botões de
+// GPIO e a direção entra na fila de curvas do joystick
+static void ui_handle_remote(const remote_packet_t *packet) {
+    uint32_t rx_us = ui_chars_us;
+    if (packet->buttons & REMOTE_BTN_A)
+        ui_handle_event(UI_EVENT_PAUSE);
+    if (packet->buttons & REMOTE_BTN_B)
+        ui_handle_event(UI_EVENT_SOUND);
+    if (packet->buttons & REMOTE_BTN_JOY)
+        ui_handle_event(UI_EVENT_JOY_PRESS);
+
+    if (packet->dir == REMOTE_DIR_NONE) {
+        remote_ack(packet->seq, REMOTE_APPLIED, rx_us);
+        return;
+    }
+    // Curva enfileirada: a confirmação sai quando o tick a aplicar (input.c)
+    input_result_t result = input_push_turn((Direction)packet->dir, rx_us, INPUT_SOURCE_REMOTE, packet->seq);
+    if (result != INPUT_QUEUED)
+        remote_ack(packet->seq, result == INPUT_REJECTED ? REMOTE_REJECTED : REMOTE_DROPPED, rx_us);
+}
+
+// Um caractere da serial: pacote do controle remoto, nome do recorde, comandos da cobra 2 (i/j/k/l, no início
+// de uma linha durante o jogo) ou uma linha do console de ajustes
+static void ui_handle_char(int ch) {
+    remote_packet_t packet;
+    remote_byte_t kind = remote_feed((uint8_t)ch, &packet);
+    if (kind == REMOTE_BYTE_PACKET)
+        ui_handle_remote(&packet);
+    if (kind != REMOTE_BYTE_TEXT)
+        return;
+
+    if (ui_state == UI_NAME_ENTRY) {
+        if (ch == '\n' || ch == '\r') {
+            ui_finish_name_entry();
+        } else if (ui_name_len < UI_NAME_MAX) {
+            ui_name[ui_name_len++] = (char)ch;
+            ui_name[ui_name_len] = '\0';
+        }
+        return;
+    }
+    if (ui_state == UI_PLAYING && console_line_empty()) {
+        switch (ch) {
+        case 'i': snake_request_turn(ui_game, 1, UP); return;
+        case 'j': snake_request_turn(ui_game, 1, LEFT); return;
+        case 'k': snake_request_turn(ui_game, 1, DOWN); return;
+        case 'l': snake_request_turn(ui_game, 1, RIGHT); return;
+        default: break;
+        }
+    }
+    console_feed((char)ch);
+}
+
+// Lê no máximo UI_CHARS_PER_STEP caracteres já recebidos, sem esperar
+static void ui_handle_chars(void) {
+    if (!ui_chars_pending)
+        return;
+    ui_chars_pending = false;
+    for (int n = 0; n < UI_CHARS_PER_STEP; n++) {
+        int ch = getchar_timeout_us(0);
+        if (ch == PICO_ERROR_TIMEOUT)
+            return;
+        ui_handle_char(ch);
+    }
+    // Sobrou entrada: continua no próximo passo
+    ui_chars_pending = true;
+}
+
+// -------------------------------------------------------------------
+// Um quadro do jogo
+
+// Conta uma tela redesenhada e enviada; as taxas fecham a cada segundo
+static void ui_count_frame(uint32_t start_us) {
+    uint32_t now = time_us_32();
+    ui_render_stats.frames++;
+    ui_fps_draws++;
+    ui_render_stats.last_draw_us = now - start_us;
+    if (ui_render_stats.last_draw_us > ui_render_stats.max_draw_us)
+        ui_render_stats.max_draw_us = ui_render_stats.last_draw_us;
+    if (now - ui_fps_window_us >= 1000000u) {
+        ui_render_stats.fps = ui_fps_draws;
+        ui_render_stats.i2c_bytes_per_s = ui_display->bytes_sent - ui_fps_bytes;
+        ui_fps_window_us = now;
+        ui_fps_draws = 0;
+        ui_fps_bytes = ui_display->bytes_sent;
+    }
+}
+
+static uint32_t ui_render_period_us(void) {
+    return 1000000u / config.render_fps;
+}
+
+// Agenda a próxima tela interpolada para o instante em que a interpolação
+// avança mais um pixel (com frame_delay_ms de 300 ms, a cada ~37 ms), sem
+// passar de render_fps; com a cobra já na célula nova, só no próximo tick.
+static void ui_schedule_render(void) {
+    if (!config.render_fps || ui_drawn_step >= CELL_SIZE) {
+        ui_next_render = at_the_end_of_time;
+        return;
+    }
+    uint32_t period_us = config.frame_delay_ms * 1000u;
+    uint32_t boundary = ui_tick_us + ((ui_drawn_step + 1) * period_us + CELL_SIZE - 1) / CELL_SIZE;
+    int32_t wait = (int32_t)(boundary - time_us_32());
+    uint32_t min_wait = ui_render_period_us();
+    ui_next_render = make_timeout_time_us(wait > (int32_t)min_wait ? (uint32_t)wait : min_wait);
+}
+
+// Quadro entre ticks: desenha o passo atual da interpolação (o agendamento
+// garante que ele avançou pelo menos um pixel)
+static void ui_render_frame(void) {
+    uint32_t period_us = config.frame_delay_ms * 1000u;
+    uint32_t elapsed = time_us_32() - ui_tick_us;
+    uint8_t step = elapsed >= period_us ? CELL_SIZE : (uint8_t)(elapsed * CELL_SIZE / period_us);
+    if (step != ui_drawn_step) {
+        uint32_t t0 = deadline_stage(DEADLINE_STAGE_DRAW);
+        snake_draw(ui_game, ui_display, step);
+        ui_drawn_step = step;
+        ui_count_frame(t0);
+        deadline_stage(DEADLINE_STAGE_UI);
+    }
+    ui_schedule_render();
+}
+
+static void ui_play_frame(void) {
+    uint32_t stage_us[TLM_STAGE_COUNT];
+    // Cada estágio fica marcado para o monitor de prazos (e para o boot após um reset)
+    uint32_t t0 = deadline_stage(DEADLINE_STAGE_INPUT);
+    ui_tick_us = t0;
+    snake_update_direction(ui_game);
+    uint32_t t1 = deadline_stage(DEADLINE_STAGE_UPDATE);
+    snake_update(ui_game, ui_led_matrix);
+    uint32_t t2 = deadline_stage(DEADLINE_STAGE_DRAW);
+    // Com a interpolação ligada, a tela do tick ainda mostra cabeça e cauda
+    // onde estavam; as telas seguintes as levam até as células novas
+    ui_drawn_step = config.render_fps ? 0 : CELL_SIZE;
+    snake_draw(ui_game, ui_display, ui_drawn_step);
+    ui_count_frame(t2);
+    uint32_t t3 = deadline_stage(DEADLINE_STAGE_AUDIO);
+    sound_set_background_enabled(ui_sound_on);
+    uint32_t t4 = deadline_stage(DEADLINE_STAGE_UI);
+
+    stage_us[TLM_STAGE_INPUT] = t1 - t0;
+    stage_us[TLM_STAGE_UPDATE] = t2 - t1;
+    stage_us[TLM_STAGE_DRAW] = t3 - t2;
+    stage_us[TLM_STAGE_AUDIO] = t4 - t3;
+    telemetry_tick(ui_game);
+    telemetry_timing(stage_us, TLM_STAGE_COUNT);
+
+    if (ui_game->game_over_flag)
+        ui_enter(UI_GAME_OVER);
+    else if (ui_game->level_complete)
+        ui_enter(UI_LEVEL_UP);
+}
+
+absolute_time_t ui_step(void) {
+    ui_event_t event;
+    while (ui_pop_event(&event))
+        ui_handle_event(event);
+    ui_handle_chars();
+
+    switch (ui_state) {
+    case UI_PLAYING:
+        if (time_reached(ui_next_frame)) {
+            // O período é contado do início de cada quadro; o quadro precisa
+            // terminar antes do início do próximo
+            absolute_time_t deadline = delayed_by_ms(ui_next_frame, config.frame_delay_ms);
+            ui_next_frame = deadline;
+            if (time_reached(ui_next_frame))
+                ui_next_frame = make_timeout_time_ms(config.frame_delay_ms);
+            ui_play_frame();
+            deadline_frame_end(deadline);
+            ui_schedule_render();
+        } else if (time_reached(ui_next_render)) {
+            ui_render_frame();
+        }
+        if (ui_state != UI_PLAYING)
+            return get_absolute_time();
+        if (absolute_time_diff_us(ui_next_render, ui_next_frame) > 0)
+            return ui_next_render;
+        return ui_next_frame;
+
+    case UI_NAME_ENTRY:
+        if (time_reached(ui_name_deadline)) {
+            ui_finish_name_entry();
+            return get_absolute_time();
+        }
+        return ui_name_deadline;
+
+    case UI_LEVEL_UP:
+        if (time_reached(ui_level_deadline)) {
+            snake_next_level(ui_game);
+            ui_enter(UI_PLAYING);
+            return get_absolute_time();
+        }
+        return ui_level_deadline;
+
+    default:
+        return at_the_end_of_time;
+    }
+}
+
+bool ui_event_pending(void) {
+    return ui_events_head != ui_events_tail || ui_chars_pending;
+}
+
+void ui_start_paused(void) {
+    ui_snapshot_saved = true;
+    ui_enter(UI_PAUSED);
+}
+
+ui_state_t ui_get_state(void) {
+    return ui_state;
+}
+
+bool ui_sound_enabled(void) {
+    return ui_sound_on;
+}
+
+void ui_get_render_stats(ui_render_stats_t *stats) {
+    *stats = ui_render_stats;
+}
@@ -0,0 +1,74 @@
+#ifndef UI_H
+#define UI_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pico/stdlib.h"
+#include "snake.h"
+#include "ssd1306.h"
+#include "matriz_led_control.h"
+
+// Máquina de estados das telas do jogo, alimentada por uma fila de eventos
+// (botões com debounce, vindos da interrupção de GPIO, e chegada de caracteres
+// pela serial). Nenhum estado espera em laço: cada ui_step faz uma quantidade
+// limitada de trabalho e informa até quando o laço principal pode dormir.
+
+#ifndef PAUSE_BTN
+#define PAUSE_BTN 5     // Botão A para pausar (GPIO 5)
+#endif
+#ifndef SOUND_BTN
+#define SOUND_BTN 6     // Botão B para mutar/desmutar som (GPIO 6)
+#endif
+
+#define UI_DEBOUNCE_US 200000     // 200 ms
+#define UI_EVENT_QUEUE_SIZE 8     // Potência de 2
+#define UI_NAME_TIMEOUT_MS 8000   // Tempo para digitar o nome de um recorde
+#define UI_NAME_MAX 8
+#define UI_CHARS_PER_STEP 16      // Caracteres da serial tratados por passo
+#define UI_LEVEL_UP_MS 1500       // Tela de troca de nível
+
+typedef enum {
+    UI_PLAYING = 0,
+    UI_PAUSED,
+    UI_GAME_OVER,
+    UI_NAME_ENTRY,
+    UI_SCOREBOARD,
+    UI_LEVEL_UP,
+    UI_STATE_COUNT
+} ui_state_t;
+
+typedef enum {
+    UI_EVENT_PAUSE = 1,   // Botão A
+    UI_EVENT_SOUND,       // Botão B
+    UI_EVENT_JOY_PRESS,   // Botão do joystick
+} ui_event_t;
+
+// Telas do jogo redesenhadas e enviadas: as dos ticks e as interpoladas entre
+// eles (uma por pixel que a interpolação avança, até render_fps por segundo).
+typedef struct {
+    uint32_t frames;           // Telas redesenhadas
+    uint16_t fps;              // Telas redesenhadas no último segundo
+    uint32_t last_draw_us;     // Desenho + envio do último redesenho
+    uint32_t max_draw_us;
+    uint32_t i2c_bytes_per_s;  // Bytes enviados ao OLED no último segundo
+} ui_render_stats_t;
+
+// Configura os botões (interrupção de GPIO) e o aviso de caracteres da serial.
+void ui_init(SnakeGame *game, ssd1306_t *display, pio_t *led_matrix);
+
+// Trata os eventos pendentes e avança o estado atual. Retorna o instante em
+// que o próximo passo precisa rodar (antes disso, só se chegar um evento).
+absolute_time_t ui_step(void);
+
+// Há eventos ou caracteres esperando (usado para acordar o laço principal)
+bool ui_event_pending(void);
+
+// Começa na tela de pausa (jogo restaurado de um retrato no boot); o retrato
+// já está na flash e não é gravado de novo
+void ui_start_paused(void);
+
+ui_state_t ui_get_state(void);
+bool ui_sound_enabled(void);
+void ui_get_render_stats(ui_render_stats_t *stats);
+
+#endif // UI_H
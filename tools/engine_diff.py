@@ -0,0 +1,194 @@
+#!/usr/bin/env python3
+"""Compara o motor atual (include/) com a referência congelada, em passo travado.
+
+Compila no host as duas versões de snake_update/snake_draw/ssd1306_* (a de
+tools/engine_diff/reference e a de include/), cada uma com o seu rand() e os
+seus stubs, e roda tools/engine_diff/harness.c: sementes aleatórias, as mesmas
+entradas (joystick, serial, autopiloto, 1 ou 2 cobras, todos os níveis) nas
+duas versões, comparando estado, framebuffer e painel emulado a cada tick e a
+cada desenho. Para na primeira divergência e mostra como reproduzi-la:
+
+    python3 tools/engine_diff.py                       # 3 configurações, 200 jogos cada
+    python3 tools/engine_diff.py --world 32x16 --seeds 1000
+    python3 tools/engine_diff.py --world 16x8 --oled 64 --first 137 --seeds 1 --dump
+    python3 tools/engine_diff.py --replay roteiro.bin --tick-ms 150
+
+Uma otimização do motor deve passar sem divergências; o tempo por chamada das
+duas versões sai lado a lado. Uma mudança de comportamento intencional congela
+a versão atual como nova referência com --freeze.
+
+Com --replay, roda uma gravação do controle remoto (tools/pad_send.py --raw)
+em vez das sementes: cada pacote passa por remote_feed e input_push_turn (os
+de include/, compilados nas duas versões) no instante gravado, com um tick do
+jogo a cada --tick-ms, e as confirmações dos pacotes também são comparadas. A
+pausa (botão A) segue a ui; no fim de jogo, o botão do joystick começa outro
+jogo no primeiro nível, sem as telas de recorde e de placar.
+
+Os níveis, sprites e a fonte são gerados de assets/ e usados pelas duas versões.
+Requer um compilador C (CC, padrão cc) e o objcopy do binutils.
+"""
+
+import argparse
+import glob
+import os
+import re
+import shutil
+import subprocess
+import sys
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+TOOLS = os.path.join(ROOT, "tools")
+HARNESS = os.path.join(TOOLS, "engine_diff")
+REFERENCE = os.path.join(HARNESS, "reference")
+INCLUDE = os.path.join(ROOT, "include")
+
+# Fontes do motor e os cabeçalhos que eles incluem (copiados por --freeze;
+# Snake.c/Snake.h ficam em minúsculas, como nos #include)
+ENGINE_SOURCES = ["Snake.c", "ssd1306.c", "world.c"]
+ENGINE_HEADERS = ["Snake.h", "ssd1306.h", "world.h", "level.h", "input.h", "telemetry.h",
+                  "effects.h", "logger.h", "matriz_led_control.h"]
+# Serviços do firmware compilados nas duas versões (sempre os de include/):
+# a fila de curvas e o decodificador do controle remoto
+SERVICE_SOURCES = ["input.c", "remote.c"]
+DEFAULT_CONFIGS = [(16, 8, 64), (32, 16, 64), (16, 8, 32)]
+
+
+def run(cmd, quiet=False):
+    result = subprocess.run(cmd, stdout=subprocess.PIPE if quiet else None, stderr=subprocess.PIPE,
+                            universal_newlines=True)
+    if result.returncode:
+        sys.stderr.write(result.stderr)
+        raise SystemExit("falhou: %s" % " ".join(cmd))
+    return result
+
+
+def freeze():
+    os.makedirs(REFERENCE, exist_ok=True)
+    for name in ENGINE_SOURCES + ENGINE_HEADERS:
+        shutil.copyfile(os.path.join(INCLUDE, name), os.path.join(REFERENCE, name.lower()))
+    print("referência congelada em %s" % os.path.relpath(REFERENCE, ROOT))
+
+
+def generate_assets(out, cols, rows):
+    py = sys.executable
+    run([py, os.path.join(TOOLS, "level_compile.py"), "--cols", str(cols), "--rows", str(rows),
+         "-o", out] + sorted(glob.glob(os.path.join(ROOT, "assets", "levels", "*.lvl"))), quiet=True)
+    sprites = glob.glob(os.path.join(ROOT, "assets", "sprites", "*.pbm")) + \
+        glob.glob(os.path.join(ROOT, "assets", "sprites", "*.png"))
+    run([py, os.path.join(TOOLS, "sprite_compile.py"), "-o", out] + sorted(sprites), quiet=True)
+    # Fonte inteira: qualquer texto sai igual nas duas versões
+    run([py, os.path.join(TOOLS, "font_compile.py"), "-o", out,
+         os.path.join(ROOT, "assets", "fonts", "snake8x8.bdf"), "--keep", " -~"], quiet=True)
+
+
+def build_side(cc, build, name, label, sources, includes, common):
+    """Compila uma versão num único objeto com só engine_<name> visível."""
+    objs = []
+    obj_dir = os.path.join(build, name)
+    os.makedirs(obj_dir, exist_ok=True)
+    defines = ["-DENGINE_OPS_NAME=engine_%s" % name, '-DENGINE_OPS_LABEL="%s"' % label]
+    for src in sources:
+        obj = os.path.join(obj_dir, os.path.splitext(os.path.basename(src))[0] + ".o")
+        run([cc, "-c", src, "-o", obj] + common + defines + ["-I" + d for d in includes])
+        objs.append(obj)
+    side = os.path.join(build, "%s.o" % name)
+    run([cc, "-r", "-nostdlib", "-o", side] + objs)
+    # Símbolos ocultos (snake_update, ssd1306_*, stubs...) viram locais: as duas
+    # versões convivem no mesmo executável
+    run(["objcopy", "--localize-hidden", side])
+    return side
+
+
+def build_config(cc, build_root, cols, rows, oled):
+    build = os.path.join(build_root, "%dx%d_%d" % (cols, rows, oled))
+    gen = os.path.join(build, "generated")
+    os.makedirs(gen, exist_ok=True)
+    generate_assets(gen, cols, rows)
+
+    # Os fontes incluem "snake.h"; num sistema de arquivos que diferencia
+    # maiúsculas, aponta para include/Snake.h
+    shim = os.path.join(build, "shim")
+    os.makedirs(shim, exist_ok=True)
+    with open(os.path.join(shim, "snake.h"), "w") as f:
+        f.write('#include "%s"\n' % os.path.join(INCLUDE, "Snake.h"))
+
+    common = ["-std=gnu11", "-O2", "-g", "-fvisibility=hidden", "-DLOG_LEVEL=0",
+              "-DWORLD_COLS=%d" % cols, "-DWORLD_ROWS=%d" % rows, "-DSSD1306_HEIGHT=%d" % oled,
+              "-Drand=engine_rand", "-Dsrand=engine_srand",
+              "-I" + HARNESS, "-I" + os.path.join(HARNESS, "host"), "-I" + gen]
+    data = [os.path.join(gen, f) for f in ("levels.c", "sprites.c", "font.c")]
+    adapter = os.path.join(HARNESS, "adapter.c")
+
+    ref_sources = [os.path.join(REFERENCE, s.lower()) for s in ENGINE_SOURCES]
+    cur_sources = [os.path.join(INCLUDE, s) for s in ENGINE_SOURCES]
+    services = [os.path.join(INCLUDE, s) for s in SERVICE_SOURCES]
+    include_shim = [] if os.path.exists(os.path.join(INCLUDE, "snake.h")) else [shim]
+    # include/ depois de reference/: só remote.h e config.h vêm de lá
+    ref = build_side(cc, build, "reference", "referência", ref_sources + data + services + [adapter],
+                     [REFERENCE, INCLUDE], common)
+    cur = build_side(cc, build, "current", "atual", cur_sources + data + services + [adapter],
+                     include_shim + [INCLUDE], common)
+
+    exe = os.path.join(build, "engine_diff")
+    run([cc, "-std=gnu11", "-O2", "-g", "-I" + HARNESS, os.path.join(HARNESS, "harness.c"),
+         ref, cur, "-o", exe])
+    return build, exe
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("--world", help="mundo em células, ex.: 32x16 (padrão: 16x8, 32x16 e OLED de 32)")
+    ap.add_argument("--oled", type=int, choices=(64, 32), default=64, help="linhas do painel com --world")
+    ap.add_argument("--seeds", type=int, default=200, help="jogos por configuração")
+    ap.add_argument("--first", type=int, default=1, help="primeira semente")
+    ap.add_argument("--ticks", type=int, default=2000, help="máximo de ticks por jogo")
+    ap.add_argument("--dump", action="store_true", help="grava as telas divergentes em PBM")
+    ap.add_argument("--replay", help="reproduz esta gravação do controle remoto (pad_send.py --raw)")
+    ap.add_argument("--tick-ms", type=int, default=300, help="período do tick com --replay (FRAME_DELAY)")
+    ap.add_argument("--build", default=os.path.join(ROOT, "build", "engine_diff"), help="diretório de build")
+    ap.add_argument("--freeze", action="store_true", help="copia o motor atual para a referência e sai")
+    args = ap.parse_args()
+
+    if args.freeze:
+        freeze()
+        return 0
+
+    if args.replay and not os.path.isfile(args.replay):
+        ap.error("gravação não encontrada: %s" % args.replay)
+
+    if args.world:
+        m = re.fullmatch(r"(\d+)x(\d+)", args.world)
+        if not m:
+            ap.error("--world espera COLSxROWS, ex.: 32x16")
+        configs = [(int(m.group(1)), int(m.group(2)), args.oled)]
+    else:
+        configs = DEFAULT_CONFIGS
+
+    cc = os.environ.get("CC", "cc")
+    failed = False
+    for cols, rows, oled in configs:
+        print("== mundo %dx%d, OLED 128x%d" % (cols, rows, oled))
+        sys.stdout.flush()
+        build, exe = build_config(cc, args.build, cols, rows, oled)
+        cmd = [exe, "--seeds", str(args.seeds), "--first", str(args.first), "--ticks", str(args.ticks)]
+        if args.replay:
+            cmd += ["--replay", os.path.abspath(args.replay), "--tick-ms", str(args.tick_ms)]
+        if args.dump:
+            cmd += ["--dump", build]
+        result = subprocess.run(cmd, stdout=subprocess.PIPE, universal_newlines=True)
+        sys.stdout.write(result.stdout)
+        if result.returncode:
+            failed = True
+            m = re.search(r"semente (\d+)", result.stdout)
+            if args.replay and result.returncode == 1:
+                print("reproduzir: python3 tools/engine_diff.py --world %dx%d --oled %d --replay %s --tick-ms %d "
+                      "--first %d --dump" % (cols, rows, oled, args.replay, args.tick_ms, args.first))
+            elif m:
+                print("reproduzir: python3 tools/engine_diff.py --world %dx%d --oled %d --first %s --seeds 1 --dump"
+                      % (cols, rows, oled, m.group(1)))
+        print()
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,274 @@
+// Adaptador de uma versão do motor para engine_ops_t. Compilado duas vezes por
+// tools/engine_diff.py: com reference/ no caminho de includes (a versão
+// congelada) e com include/ (a atual). A fila de curvas (input.c) e o
+// decodificador do controle remoto (remote.c) são os do firmware, uma cópia
+// por versão; os outros serviços que o motor chama (amostrador, telemetria,
+// efeitos, I2C) viram stubs aqui. rand() é renomeado para engine_rand na
+// compilação, para cada versão ter o seu gerador.
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "engine.h"
+#include "snake.h"
+#include "input.h"
+#include "remote.h"
+#include "config.h"
+#include "telemetry.h"
+#include "effects.h"
+#include "levels.h"
+
+#if !defined(ENGINE_OPS_NAME) || !defined(ENGINE_OPS_LABEL)
+#error "Defina ENGINE_OPS_NAME (engine_reference ou engine_current) e ENGINE_OPS_LABEL"
+#endif
+
+static SnakeGame adapter_game;
+static ssd1306_t adapter_display;
+
+// --- rand() próprio (mesmo LCG nas duas versões) ---------------------------
+
+static uint32_t adapter_rand_state = 1;
+
+int engine_rand(void) {
+    adapter_rand_state = adapter_rand_state * 1103515245u + 12345u;
+    return (int)((adapter_rand_state >> 16) & 0x7FFF);
+}
+
+void engine_srand(unsigned int seed) {
+    adapter_rand_state = seed;
+}
+
+// --- Amostrador do joystick (input.c): nunca dispara no host ---------------
+
+config_t config;
+
+bool add_repeating_timer_ms(int32_t delay_ms, repeating_timer_callback_t callback, void *user_data,
+                            repeating_timer_t *out) {
+    return true;
+}
+
+bool cancel_repeating_timer(repeating_timer_t *timer) {
+    return true;
+}
+
+void adc_select_input(uint input) {
+}
+
+uint16_t adc_read(void) {
+    return JOYSTICK_CENTER;
+}
+
+// Sem relógio: as latências medidas por input.c e remote.c saem zeradas
+uint32_t time_us_32(void) {
+    return 0;
+}
+
+// --- Telemetria: só as confirmações do controle remoto são contadas --------
+
+static uint32_t adapter_remote_results[ENGINE_REMOTE_RESULTS];
+
+void telemetry_event(telemetry_event_t event, const uint8_t *data, uint8_t len) {
+    if (event == TLM_EVENT_REMOTE && len >= 2 && data[1] < ENGINE_REMOTE_RESULTS)
+        adapter_remote_results[data[1]]++;
+}
+
+// --- Efeitos e log: sem efeito no host -------------------------------------
+
+effect_t effects_led_fade(const effect_key_t *keys, uint8_t count, uint8_t repeat) {
+    return 0;
+}
+
+effect_t effects_matrix_play(const effect_frame_t *frames, uint8_t count, uint8_t repeat) {
+    return 0;
+}
+
+void effects_cancel(effect_t effect) {
+}
+
+void logger_record(uint8_t level, const char *fmt, uint8_t nargs,
+                   uint32_t a0, uint32_t a1, uint32_t a2, uint32_t a3) {
+}
+
+void panic(const char *fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    vfprintf(stderr, fmt, args);
+    va_end(args);
+    fputc('\n', stderr);
+    exit(2);
+}
+
+// --- Painel emulado: interpreta a janela (0x21/0x22) e os dados do SSD1306 --
+
+static uint8_t adapter_panel[ENGINE_MAX_FB];
+static uint8_t adapter_col_start, adapter_col_end, adapter_page_start, adapter_page_end;
+static uint8_t adapter_col, adapter_page;
+static uint32_t adapter_wire_bytes = 0;
+
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop) {
+    adapter_wire_bytes += len + 1;  // Mais o endereço
+    if (len == 0)
+        return 0;
+    if (src[0] == 0x00) {
+        // Comandos: só a janela importa para onde vão os dados
+        for (size_t i = 1; i < len; i++) {
+            if (src[i] == 0x21 && i + 2 < len) {
+                adapter_col = adapter_col_start = src[i + 1];
+                adapter_col_end = src[i + 2];
+                i += 2;
+            } else if (src[i] == 0x22 && i + 2 < len) {
+                adapter_page = adapter_page_start = src[i + 1];
+                adapter_page_end = src[i + 2];
+                i += 2;
+            }
+        }
+        return (int)len;
+    }
+    for (size_t i = 1; i < len; i++) {
+        size_t at = (size_t)adapter_page * SSD1306_WIDTH + adapter_col;
+        if (at < sizeof(adapter_panel))
+            adapter_panel[at] = src[i];
+        if (++adapter_col > adapter_col_end) {
+            adapter_col = adapter_col_start;
+            if (++adapter_page > adapter_page_end)
+                adapter_page = adapter_page_start;
+        }
+    }
+    return (int)len;
+}
+
+// --- Operações --------------------------------------------------------------
+
+static void adapter_reset(uint32_t seed, uint8_t players, uint8_t level) {
+    if (!adapter_display.ram_buffer) {
+        ssd1306_init(&adapter_display, SSD1306_WIDTH, SSD1306_HEIGHT, false, 0x3C, NULL);
+        ssd1306_config(&adapter_display);
+    }
+    engine_srand(seed);
+    input_init();
+    memset(adapter_remote_results, 0, sizeof(adapter_remote_results));
+    memset(&adapter_game, 0, sizeof(adapter_game));
+    snake_set_players(&adapter_game, players);
+    snake_set_level(&adapter_game, level);
+    snake_init(&adapter_game);
+}
+
+static void adapter_next_level(void) {
+    snake_next_level(&adapter_game);
+}
+
+static void adapter_set_control(uint8_t id, uint8_t control) {
+    snake_set_control(&adapter_game, id, (SnakeControl)control);
+}
+
+static void adapter_request_turn(uint8_t id, uint8_t dir) {
+    snake_request_turn(&adapter_game, id, (Direction)dir);
+}
+
+static void adapter_push_turn(uint8_t dir) {
+    input_push_turn((Direction)dir, 0, INPUT_SOURCE_JOYSTICK, 0);
+}
+
+// A parte de ui_handle_remote que não depende da ui
+static void adapter_feed(const uint8_t *data, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        remote_packet_t packet;
+        if (remote_feed(data[i], &packet) != REMOTE_BYTE_PACKET)
+            continue;
+        if (packet.dir == REMOTE_DIR_NONE) {
+            remote_ack(packet.seq, REMOTE_APPLIED, 0);
+            continue;
+        }
+        input_result_t result = input_push_turn((Direction)packet.dir, 0, INPUT_SOURCE_REMOTE, packet.seq);
+        if (result != INPUT_QUEUED)
+            remote_ack(packet.seq, result == INPUT_REJECTED ? REMOTE_REJECTED : REMOTE_DROPPED, 0);
+    }
+}
+
+static void adapter_set_input(bool enabled) {
+    input_set_enabled(enabled);
+}
+
+static void adapter_remote_results_copy(uint32_t counts[ENGINE_REMOTE_RESULTS]) {
+    memcpy(counts, adapter_remote_results, sizeof(adapter_remote_results));
+}
+
+static void adapter_tick(void) {
+    snake_update_direction(&adapter_game);
+    snake_update(&adapter_game, NULL);
+}
+
+static void adapter_draw(uint8_t step_px) {
+    snake_draw(&adapter_game, &adapter_display, step_px);
+}
+
+static void adapter_game_over_screen(void) {
+    snake_game_over_screen(&adapter_game, &adapter_display, NULL);
+}
+
+static void adapter_state(engine_state_t *out) {
+    memset(out, 0, sizeof(*out));
+    out->num_snakes = adapter_game.num_snakes;
+    for (uint8_t id = 0; id < adapter_game.num_snakes && id < ENGINE_MAX_PLAYERS; id++) {
+        const Snake *snake = &adapter_game.snakes[id];
+        engine_snake_t *s = &out->snakes[id];
+        s->length = snake->length;
+        s->direction = (uint8_t)snake->direction;
+        s->control = (uint8_t)snake->control;
+        s->alive = snake->alive;
+        s->score = snake->score;
+        s->tail_prev.x = snake->tail_prev.x;
+        s->tail_prev.y = snake->tail_prev.y;
+        for (uint16_t i = 0; i < snake->length && i < ENGINE_MAX_BODY; i++) {
+            Position pos = snake_segment(snake, (uint8_t)i);
+            s->body[i].x = pos.x;
+            s->body[i].y = pos.y;
+        }
+    }
+    out->food.x = adapter_game.food.x;
+    out->food.y = adapter_game.food.y;
+    out->camera_x = adapter_game.camera_x;
+    out->camera_y = adapter_game.camera_y;
+    out->level_index = adapter_game.level_index;
+    out->level_eaten = adapter_game.level_eaten;
+    out->level_complete = adapter_game.level_complete;
+    out->stepped = adapter_game.stepped;
+    out->game_over = adapter_game.game_over_flag;
+    out->winner = adapter_game.winner;
+}
+
+static const uint8_t *adapter_framebuffer(size_t *len) {
+    *len = adapter_display.bufsize - 1;
+    return adapter_display.ram_buffer + 1;
+}
+
+static const uint8_t *adapter_panel_memory(size_t *len) {
+    *len = (size_t)SSD1306_WIDTH * SSD1306_PAGES;
+    return adapter_panel;
+}
+
+static uint32_t adapter_bytes_sent(void) {
+    return adapter_wire_bytes;
+}
+
+__attribute__((visibility("default"))) const engine_ops_t ENGINE_OPS_NAME = {
+    .name = ENGINE_OPS_LABEL,
+    .level_count = LEVEL_COUNT,
+    .cell_size = CELL_SIZE,
+    .reset = adapter_reset,
+    .next_level = adapter_next_level,
+    .set_control = adapter_set_control,
+    .request_turn = adapter_request_turn,
+    .push_turn = adapter_push_turn,
+    .feed = adapter_feed,
+    .set_input = adapter_set_input,
+    .remote_results = adapter_remote_results_copy,
+    .tick = adapter_tick,
+    .draw = adapter_draw,
+    .game_over_screen = adapter_game_over_screen,
+    .state = adapter_state,
+    .framebuffer = adapter_framebuffer,
+    .panel = adapter_panel_memory,
+    .bytes_sent = adapter_bytes_sent,
+};
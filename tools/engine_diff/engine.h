@@ -0,0 +1,81 @@
+#ifndef ENGINE_DIFF_ENGINE_H
+#define ENGINE_DIFF_ENGINE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Interface comum das duas versões do motor (referência congelada e a atual
+// de include/). Cada versão é compilada com o adaptador (adapter.c) num objeto
+// próprio com os símbolos internos localizados, então as duas convivem no mesmo
+// executável e o harness (harness.c) só as enxerga por engine_ops_t.
+
+#define ENGINE_MAX_PLAYERS 2
+#define ENGINE_MAX_BODY 256
+#define ENGINE_MAX_FB 1024           // 128x64
+#define ENGINE_REMOTE_RESULTS 4      // remote_result_t (remote.h)
+
+typedef struct {
+    uint8_t x;
+    uint8_t y;
+} engine_pos_t;
+
+typedef struct {
+    uint16_t length;
+    uint8_t direction;
+    uint8_t control;
+    bool alive;
+    int32_t score;
+    engine_pos_t tail_prev;
+    engine_pos_t body[ENGINE_MAX_BODY];  // Cabeça primeiro; só 'length' valem
+} engine_snake_t;
+
+// Estado observável do jogo, independente do layout de SnakeGame
+typedef struct {
+    uint8_t num_snakes;
+    engine_snake_t snakes[ENGINE_MAX_PLAYERS];
+    engine_pos_t food;
+    int16_t camera_x;
+    int16_t camera_y;
+    uint8_t level_index;
+    uint8_t level_eaten;
+    bool level_complete;
+    bool stepped;
+    bool game_over;
+    int8_t winner;
+} engine_state_t;
+
+typedef struct {
+    const char *name;
+    uint8_t level_count;
+    uint8_t cell_size;
+    // Novo jogo: semente do rand() da versão, cobras e nível
+    void (*reset)(uint32_t seed, uint8_t players, uint8_t level);
+    void (*next_level)(void);
+    void (*set_control)(uint8_t id, uint8_t control);
+    void (*request_turn)(uint8_t id, uint8_t dir);
+    // Curva do joystick na fila do amostrador (input_push_turn de input.c)
+    void (*push_turn)(uint8_t dir);
+    // Bytes do controle remoto: remote_feed e a curva de cada pacote na fila,
+    // como ui_handle_remote (os botões ficam com o harness)
+    void (*feed)(const uint8_t *data, size_t len);
+    // input_set_enabled: desligada em pausa e nas telas
+    void (*set_input)(bool enabled);
+    // Confirmações dos pacotes remotos por resultado, desde o último reset
+    void (*remote_results)(uint32_t counts[ENGINE_REMOTE_RESULTS]);
+    // snake_update_direction + snake_update
+    void (*tick)(void);
+    // snake_draw (inclui o envio ao painel emulado)
+    void (*draw)(uint8_t step_px);
+    void (*game_over_screen)(void);
+    void (*state)(engine_state_t *out);
+    // Framebuffer (sem o byte de controle) e a memória do painel emulado
+    const uint8_t *(*framebuffer)(size_t *len);
+    const uint8_t *(*panel)(size_t *len);
+    uint32_t (*bytes_sent)(void);
+} engine_ops_t;
+
+extern const engine_ops_t engine_reference;
+extern const engine_ops_t engine_current;
+
+#endif // ENGINE_DIFF_ENGINE_H
@@ -0,0 +1,504 @@
+// Harness diferencial do motor: roda a versão de referência (congelada em
+// reference/) e a atual (include/) em passo travado, com as mesmas sementes e
+// as mesmas entradas, e compara o estado do jogo, o framebuffer e a memória do
+// painel emulado depois de cada tick e de cada desenho. Para na primeira
+// divergência, com a semente que a reproduz, e mostra o tempo das duas versões
+// lado a lado. Compilado e executado por tools/engine_diff.py.
+//
+// Com --replay, em vez das sementes, reproduz uma gravação do controle remoto
+// (tools/pad_send.py --raw) nas duas versões: os pacotes passam por
+// remote_feed e input_push_turn no instante gravado, com um tick a cada
+// --tick-ms.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "engine.h"
+
+// SnakeControl (Snake.h)
+#define CTRL_JOYSTICK 0
+#define CTRL_SERIAL 1
+#define CTRL_AUTOPILOT 2
+
+// Botões do pacote do controle remoto (remote.h)
+#define REMOTE_BTN_A 0x10
+#define REMOTE_BTN_JOY 0x40
+#define REMOTE_PACKET_BYTES 4
+
+// Gravação de tools/pad_send.py --raw: "PAD1" e [atraso em ms u16][pacote]
+#define REPLAY_MAGIC "PAD1"
+#define REPLAY_RECORD (2 + REMOTE_PACKET_BYTES)
+// Tela de troca de nível (UI_LEVEL_UP_MS, ui.h) e quanto o jogo segue depois
+// do último pacote
+#define REPLAY_LEVEL_UP_MS 1500
+#define REPLAY_TAIL_MS 1000
+
+enum { OP_TICK = 0, OP_DRAW, OP_SCREEN, OP_COUNT };
+static const char *const op_names[OP_COUNT] = {"tick", "desenho", "tela final"};
+
+typedef struct {
+    const engine_ops_t *ops;
+    uint64_t ns[OP_COUNT];
+    uint32_t calls[OP_COUNT];
+} side_t;
+
+static side_t sides[2] = {{.ops = &engine_reference}, {.ops = &engine_current}};
+static const char *dump_dir = NULL;
+static uint32_t side_order = 0;   // Alterna quem roda primeiro, para não favorecer uma versão
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+// Gerador das entradas (independente do rand() de cada versão)
+static uint32_t input_state;
+
+static uint32_t input_rand(void) {
+    input_state ^= input_state << 13;
+    input_state ^= input_state >> 17;
+    input_state ^= input_state << 5;
+    return input_state;
+}
+
+static bool chance(uint32_t one_in) {
+    return input_rand() % one_in == 0;
+}
+
+// --- Operações nas duas versões ------------------------------------------------
+
+// Os argumentos de 'call' são avaliados uma vez por versão
+#define BOTH(call) do { for (int i_ = 0; i_ < 2; i_++) sides[i_].ops->call; } while (0)
+
+static void timed(int op, void (*run)(const engine_ops_t *, uint8_t), uint8_t arg) {
+    side_order++;
+    for (int k = 0; k < 2; k++) {
+        side_t *side = &sides[(k + side_order) & 1];
+        uint64_t start = now_ns();
+        run(side->ops, arg);
+        side->ns[op] += now_ns() - start;
+        side->calls[op]++;
+    }
+}
+
+static void run_tick(const engine_ops_t *ops, uint8_t arg) {
+    ops->tick();
+}
+
+static void run_draw(const engine_ops_t *ops, uint8_t step) {
+    ops->draw(step);
+}
+
+static void run_screen(const engine_ops_t *ops, uint8_t arg) {
+    ops->game_over_screen();
+}
+
+// --- Comparação -------------------------------------------------------------------
+
+static void write_pbm(const char *path, const uint8_t *fb, size_t len) {
+    FILE *f = fopen(path, "w");
+    if (!f)
+        return;
+    size_t pages = len / 128;
+    fprintf(f, "P1\n128 %zu\n", pages * 8);
+    for (size_t y = 0; y < pages * 8; y++) {
+        for (size_t x = 0; x < 128; x++)
+            fputs(fb[(y / 8) * 128 + x] >> (y % 8) & 1 ? "1" : "0", f);
+        fputc('\n', f);
+    }
+    fclose(f);
+}
+
+static bool compare_bytes(const char *what, const uint8_t *ref, size_t ref_len, const uint8_t *cur, size_t cur_len) {
+    if (ref_len != cur_len) {
+        printf("  %s: %zu bytes na referência, %zu na atual\n", what, ref_len, cur_len);
+        return false;
+    }
+    for (size_t i = 0; i < ref_len; i++) {
+        if (ref[i] == cur[i])
+            continue;
+        printf("  %s: página %zu, coluna %zu: referência 0x%02X, atual 0x%02X\n",
+               what, i / 128, i % 128, ref[i], cur[i]);
+        if (dump_dir) {
+            char path[512];
+            snprintf(path, sizeof(path), "%s/%s_referencia.pbm", dump_dir, what);
+            write_pbm(path, ref, ref_len);
+            snprintf(path, sizeof(path), "%s/%s_atual.pbm", dump_dir, what);
+            write_pbm(path, cur, cur_len);
+            printf("  imagens em %s/%s_{referencia,atual}.pbm\n", dump_dir, what);
+        }
+        return false;
+    }
+    return true;
+}
+
+#define FIELD(name, fmt, a, b) \
+    if ((a) != (b)) { printf("  %s: referência " fmt ", atual " fmt "\n", name, a, b); return false; }
+
+static bool compare_state(void) {
+    static engine_state_t ref, cur;
+    sides[0].ops->state(&ref);
+    sides[1].ops->state(&cur);
+    FIELD("cobras", "%u", ref.num_snakes, cur.num_snakes);
+    for (uint8_t id = 0; id < ref.num_snakes; id++) {
+        const engine_snake_t *a = &ref.snakes[id], *b = &cur.snakes[id];
+        char name[48];
+        snprintf(name, sizeof(name), "cobra %u viva", id);
+        FIELD(name, "%d", a->alive, b->alive);
+        snprintf(name, sizeof(name), "cobra %u comprimento", id);
+        FIELD(name, "%u", a->length, b->length);
+        snprintf(name, sizeof(name), "cobra %u direção", id);
+        FIELD(name, "%u", a->direction, b->direction);
+        snprintf(name, sizeof(name), "cobra %u controle", id);
+        FIELD(name, "%u", a->control, b->control);
+        snprintf(name, sizeof(name), "cobra %u pontos", id);
+        FIELD(name, "%d", (int)a->score, (int)b->score);
+        for (uint16_t i = 0; i < a->length && i < ENGINE_MAX_BODY; i++) {
+            if (a->body[i].x != b->body[i].x || a->body[i].y != b->body[i].y) {
+                printf("  cobra %u segmento %u: referência (%u,%u), atual (%u,%u)\n", id, i,
+                       a->body[i].x, a->body[i].y, b->body[i].x, b->body[i].y);
+                return false;
+            }
+        }
+        if (a->tail_prev.x != b->tail_prev.x || a->tail_prev.y != b->tail_prev.y) {
+            printf("  cobra %u cauda anterior: referência (%u,%u), atual (%u,%u)\n", id,
+                   a->tail_prev.x, a->tail_prev.y, b->tail_prev.x, b->tail_prev.y);
+            return false;
+        }
+    }
+    if (ref.food.x != cur.food.x || ref.food.y != cur.food.y) {
+        printf("  comida: referência (%u,%u), atual (%u,%u)\n", ref.food.x, ref.food.y, cur.food.x, cur.food.y);
+        return false;
+    }
+    FIELD("câmera x", "%d", ref.camera_x, cur.camera_x);
+    FIELD("câmera y", "%d", ref.camera_y, cur.camera_y);
+    FIELD("nível", "%u", ref.level_index, cur.level_index);
+    FIELD("comidas no nível", "%u", ref.level_eaten, cur.level_eaten);
+    FIELD("nível completo", "%d", ref.level_complete, cur.level_complete);
+    FIELD("stepped", "%d", ref.stepped, cur.stepped);
+    FIELD("fim de jogo", "%d", ref.game_over, cur.game_over);
+    FIELD("vencedora", "%d", ref.winner, cur.winner);
+    return true;
+}
+
+static bool compare_remote(void) {
+    static const char *const names[ENGINE_REMOTE_RESULTS] = {
+        "pacotes aplicados", "pacotes rejeitados", "pacotes descartados", "pacotes esvaziados"};
+    uint32_t ref[ENGINE_REMOTE_RESULTS], cur[ENGINE_REMOTE_RESULTS];
+    sides[0].ops->remote_results(ref);
+    sides[1].ops->remote_results(cur);
+    for (int i = 0; i < ENGINE_REMOTE_RESULTS; i++)
+        FIELD(names[i], "%u", ref[i], cur[i]);
+    return true;
+}
+
+static bool compare_screen(void) {
+    size_t ref_len, cur_len;
+    const uint8_t *ref = sides[0].ops->framebuffer(&ref_len);
+    const uint8_t *cur = sides[1].ops->framebuffer(&cur_len);
+    if (!compare_bytes("framebuffer", ref, ref_len, cur, cur_len))
+        return false;
+    ref = sides[0].ops->panel(&ref_len);
+    cur = sides[1].ops->panel(&cur_len);
+    return compare_bytes("painel", ref, ref_len, cur, cur_len);
+}
+
+// --- Um jogo ------------------------------------------------------------------------
+
+typedef struct {
+    uint32_t ticks;
+    uint32_t draws;
+} totals_t;
+
+// Retorna false na primeira divergência, já descrita
+static bool run_game(uint32_t seed, uint32_t max_ticks, totals_t *totals) {
+    input_state = seed * 2654435761u + 1;
+    if (!input_state)
+        input_state = 1;
+    uint8_t players = 1 + input_rand() % ENGINE_MAX_PLAYERS;
+    uint8_t level = input_rand() % sides[0].ops->level_count;
+    bool joystick = chance(2);     // Senão, autopiloto com curvas pela serial
+    uint8_t cell = sides[0].ops->cell_size;
+
+    const char *where = "início";
+    uint32_t tick = 0;
+    BOTH(reset(seed, players, level));
+    if (!joystick)
+        BOTH(set_control(0, CTRL_AUTOPILOT));
+    bool ok = compare_state();
+    if (ok) {
+        timed(OP_DRAW, run_draw, 0);
+        totals->draws++;
+        ok = compare_state() && compare_screen();
+    }
+
+    while (ok && tick < max_ticks) {
+        // Entradas do tick, iguais para as duas versões
+        // (sorteadas antes: BOTH avalia os argumentos uma vez por versão)
+        uint8_t dir = input_rand() % 4, dir2 = input_rand() % 4;
+        if (joystick) {
+            if (chance(4))
+                BOTH(push_turn(dir));
+        } else if (chance(8)) {
+            BOTH(request_turn(0, dir));
+        } else if (chance(16)) {
+            BOTH(set_control(0, CTRL_AUTOPILOT));
+        }
+        if (players > 1 && chance(10))
+            BOTH(request_turn(1, dir2));
+
+        where = "tick";
+        timed(OP_TICK, run_tick, 0);
+        tick++;
+        totals->ticks++;
+        if (!(ok = compare_state()))
+            break;
+
+        // Quadros entre os ticks: o do tick, um interpolado e o do fim do intervalo
+        uint8_t steps[3] = {0, (uint8_t)(1 + input_rand() % (cell - 1)), cell};
+        for (int i = 0; i < 3 && ok; i++) {
+            where = "desenho";
+            timed(OP_DRAW, run_draw, steps[i]);
+            totals->draws++;
+            ok = compare_state() && compare_screen();
+        }
+        if (!ok)
+            break;
+
+        engine_state_t state;
+        sides[0].ops->state(&state);
+        if (state.game_over) {
+            where = "tela de fim de jogo";
+            timed(OP_SCREEN, run_screen, 0);
+            ok = compare_screen();
+            break;
+        }
+        if (state.level_complete) {
+            where = "troca de nível";
+            BOTH(next_level());
+            ok = compare_state();
+        }
+    }
+
+    if (!ok) {
+        printf("primeira divergência: semente %u, tick %u (%s), %u cobra(s), nível %u, %s\n",
+               seed, tick, where, players, level + 1, joystick ? "joystick" : "autopiloto/serial");
+    }
+    return ok;
+}
+
+// --- Reprodução de uma gravação do controle remoto -----------------------------------
+
+typedef struct {
+    uint32_t at_ms;                          // Desde o início da gravação
+    uint8_t bytes[REMOTE_PACKET_BYTES];
+} replay_packet_t;
+
+static bool load_replay(const char *path, replay_packet_t **out, uint32_t *count) {
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        perror(path);
+        return false;
+    }
+    char magic[4];
+    replay_packet_t *packets = NULL;
+    uint32_t n = 0, at = 0;
+    uint8_t record[REPLAY_RECORD];
+    size_t got = fread(magic, 1, sizeof(magic), f);
+    if (got != sizeof(magic) || memcmp(magic, REPLAY_MAGIC, sizeof(magic)) != 0) {
+        fprintf(stderr, "%s: não é uma gravação de tools/pad_send.py --raw\n", path);
+        fclose(f);
+        return false;
+    }
+    while ((got = fread(record, 1, sizeof(record), f)) == sizeof(record)) {
+        replay_packet_t *grown = realloc(packets, (n + 1) * sizeof(*packets));
+        if (!grown)
+            break;
+        packets = grown;
+        at += record[0] | (record[1] << 8);
+        packets[n].at_ms = at;
+        memcpy(packets[n].bytes, record + 2, REMOTE_PACKET_BYTES);
+        n++;
+    }
+    fclose(f);
+    if (got != 0)
+        fprintf(stderr, "%s: gravação truncada, usando %u pacotes\n", path, n);
+    *out = packets;
+    *count = n;
+    return true;
+}
+
+typedef enum { REPLAY_PLAYING = 0, REPLAY_PAUSED, REPLAY_LEVEL_UP, REPLAY_GAME_OVER } replay_state_t;
+
+// Desenhos do tick (o do tick, um interpolado e o do fim do intervalo)
+static bool replay_draws(uint32_t tick, totals_t *totals) {
+    uint8_t cell = sides[0].ops->cell_size;
+    uint8_t steps[3] = {0, (uint8_t)(1 + tick % (cell - 1)), cell};
+    for (int i = 0; i < 3; i++) {
+        timed(OP_DRAW, run_draw, steps[i]);
+        totals->draws++;
+        if (!compare_state() || !compare_screen())
+            return false;
+    }
+    return true;
+}
+
+// Os botões seguem a ui só no que muda o motor: A pausa e retoma (a entrada
+// fica desligada na pausa) e o botão do joystick, no fim de jogo, começa um
+// jogo novo no primeiro nível (sem as telas de recorde e de placar).
+// Retorna false na primeira divergência, já descrita.
+static bool run_replay(const replay_packet_t *packets, uint32_t count, uint32_t seed,
+                       uint32_t tick_ms, uint32_t max_ticks, totals_t *totals) {
+    replay_state_t state = REPLAY_PLAYING;
+    uint32_t next = 0, tick = 0, now = 0, level_up_until = 0, games = 1;
+    uint32_t end = (count ? packets[count - 1].at_ms : 0) + REPLAY_TAIL_MS;
+    const char *where = "início";
+
+    BOTH(reset(seed, 1, 0));
+    bool ok = compare_state();
+    if (ok) {
+        timed(OP_DRAW, run_draw, 0);
+        totals->draws++;
+        ok = compare_state() && compare_screen();
+    }
+
+    while (ok && now <= end && tick < max_ticks) {
+        // Pacotes que chegaram até este tick, na ordem gravada
+        for (; ok && next < count && packets[next].at_ms <= now; next++) {
+            const uint8_t *pkt = packets[next].bytes;
+            uint8_t buttons = pkt[1] & 0xF0;
+            where = "pacote";
+            if ((buttons & REMOTE_BTN_A) && (state == REPLAY_PLAYING || state == REPLAY_PAUSED)) {
+                state = state == REPLAY_PLAYING ? REPLAY_PAUSED : REPLAY_PLAYING;
+                BOTH(set_input(state == REPLAY_PLAYING));
+            }
+            if ((buttons & REMOTE_BTN_JOY) && state == REPLAY_GAME_OVER) {
+                BOTH(reset(seed + games, 1, 0));
+                games++;
+                state = REPLAY_PLAYING;
+            }
+            BOTH(feed(pkt, REMOTE_PACKET_BYTES));
+            ok = compare_state() && compare_remote();
+        }
+        if (!ok)
+            break;
+
+        if (state == REPLAY_LEVEL_UP && now >= level_up_until) {
+            where = "troca de nível";
+            BOTH(next_level());
+            BOTH(set_input(true));
+            state = REPLAY_PLAYING;
+            if (!(ok = compare_state() && compare_remote()))
+                break;
+        }
+        if (state == REPLAY_PLAYING) {
+            where = "tick";
+            timed(OP_TICK, run_tick, 0);
+            tick++;
+            totals->ticks++;
+            if (!(ok = compare_state() && compare_remote()))
+                break;
+            where = "desenho";
+            if (!(ok = replay_draws(tick, totals)))
+                break;
+
+            engine_state_t game;
+            sides[0].ops->state(&game);
+            if (game.game_over) {
+                where = "tela de fim de jogo";
+                BOTH(set_input(false));
+                timed(OP_SCREEN, run_screen, 0);
+                if (!(ok = compare_screen()))
+                    break;
+                state = REPLAY_GAME_OVER;
+            } else if (game.level_complete) {
+                BOTH(set_input(false));
+                state = REPLAY_LEVEL_UP;
+                level_up_until = now + REPLAY_LEVEL_UP_MS;
+            }
+        }
+        now += tick_ms;
+    }
+
+    if (!ok) {
+        printf("primeira divergência: %u ms, tick %u (%s), com %u de %u pacotes entregues\n",
+               now, tick, where, next, count);
+        return false;
+    }
+    uint32_t results[ENGINE_REMOTE_RESULTS];
+    sides[0].ops->remote_results(results);
+    printf("%u pacotes em %u jogo(s), %u ticks, %u desenhos: nenhuma divergência\n",
+           next, games, totals->ticks, totals->draws);
+    printf("último jogo: %u aplicados, %u rejeitados, %u descartados, %u esvaziados\n",
+           results[0], results[1], results[2], results[3]);
+    return true;
+}
+
+// --- Relatório ----------------------------------------------------------------------
+
+static void print_timing(void) {
+    printf("\n%-12s %14s %14s %8s\n", "ns/chamada", sides[0].ops->name, sides[1].ops->name, "razão");
+    for (int op = 0; op < OP_COUNT; op++) {
+        if (!sides[0].calls[op])
+            continue;
+        double ref = (double)sides[0].ns[op] / sides[0].calls[op];
+        double cur = (double)sides[1].ns[op] / sides[1].calls[op];
+        printf("%-12s %14.0f %14.0f %7.2fx\n", op_names[op], ref, cur, cur / ref);
+    }
+    printf("%-12s %14u %14u\n", "bytes i2c", sides[0].ops->bytes_sent(), sides[1].ops->bytes_sent());
+}
+
+static void usage(const char *argv0) {
+    fprintf(stderr, "uso: %s [--seeds N] [--first S] [--ticks T] [--dump DIR] [--replay ARQ [--tick-ms MS]]\n",
+            argv0);
+    exit(2);
+}
+
+int main(int argc, char **argv) {
+    uint32_t seeds = 200, first = 1, max_ticks = 2000, tick_ms = 300;
+    const char *replay = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 >= argc)
+            usage(argv[0]);
+        if (strcmp(argv[i], "--seeds") == 0)
+            seeds = (uint32_t)strtoul(argv[++i], NULL, 0);
+        else if (strcmp(argv[i], "--first") == 0)
+            first = (uint32_t)strtoul(argv[++i], NULL, 0);
+        else if (strcmp(argv[i], "--ticks") == 0)
+            max_ticks = (uint32_t)strtoul(argv[++i], NULL, 0);
+        else if (strcmp(argv[i], "--dump") == 0)
+            dump_dir = argv[++i];
+        else if (strcmp(argv[i], "--replay") == 0)
+            replay = argv[++i];
+        else if (strcmp(argv[i], "--tick-ms") == 0)
+            tick_ms = (uint32_t)strtoul(argv[++i], NULL, 0);
+        else
+            usage(argv[0]);
+    }
+
+    totals_t totals = {0, 0};
+    uint32_t seed;
+    bool ok = true;
+    if (replay) {
+        replay_packet_t *packets = NULL;
+        uint32_t count = 0;
+        if (!tick_ms)
+            usage(argv[0]);
+        if (!load_replay(replay, &packets, &count))
+            return 2;
+        ok = run_replay(packets, count, first, tick_ms, max_ticks, &totals);
+        free(packets);
+        print_timing();
+        return ok ? 0 : 1;
+    }
+
+    for (seed = first; seed < first + seeds && ok; seed++)
+        ok = run_game(seed, max_ticks, &totals);
+
+    if (ok)
+        printf("%u jogos, %u ticks, %u desenhos: nenhuma divergência\n", seeds, totals.ticks, totals.draws);
+    print_timing();
+    return ok ? 0 : 1;
+}
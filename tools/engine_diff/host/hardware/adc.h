@@ -0,0 +1,10 @@
+#ifndef ENGINE_DIFF_HARDWARE_ADC_H
+#define ENGINE_DIFF_HARDWARE_ADC_H
+
+#include "pico/stdlib.h"
+
+// Joystick centrado: o adaptador (adapter.c) responde sempre o meio da escala
+void adc_select_input(uint input);
+uint16_t adc_read(void);
+
+#endif // ENGINE_DIFF_HARDWARE_ADC_H
@@ -0,0 +1,11 @@
+#ifndef ENGINE_DIFF_HARDWARE_I2C_H
+#define ENGINE_DIFF_HARDWARE_I2C_H
+
+#include "pico/stdlib.h"
+
+// O adaptador (adapter.c) recebe as escritas e as aplica num painel emulado
+typedef struct i2c_inst i2c_inst_t;
+
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop);
+
+#endif // ENGINE_DIFF_HARDWARE_I2C_H
@@ -0,0 +1,10 @@
+#ifndef ENGINE_DIFF_HARDWARE_PIO_H
+#define ENGINE_DIFF_HARDWARE_PIO_H
+
+#include "pico/stdlib.h"
+
+// Só o tipo, para o pio_t de matriz_led_control.h
+typedef struct pio_hw pio_hw_t;
+typedef pio_hw_t *PIO;
+
+#endif // ENGINE_DIFF_HARDWARE_PIO_H
@@ -0,0 +1,6 @@
+#ifndef ENGINE_DIFF_HARDWARE_PWM_H
+#define ENGINE_DIFF_HARDWARE_PWM_H
+
+// Vazio: incluído pelo motor, mas nada dele é usado no host
+
+#endif // ENGINE_DIFF_HARDWARE_PWM_H
@@ -0,0 +1,15 @@
+#ifndef ENGINE_DIFF_HARDWARE_SYNC_H
+#define ENGINE_DIFF_HARDWARE_SYNC_H
+
+#include <stdint.h>
+
+// Uma só thread no host: não há interrupções para bloquear
+static inline uint32_t save_and_disable_interrupts(void) {
+    return 0;
+}
+
+static inline void restore_interrupts(uint32_t status) {
+    (void)status;
+}
+
+#endif // ENGINE_DIFF_HARDWARE_SYNC_H
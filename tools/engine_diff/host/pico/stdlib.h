@@ -0,0 +1,27 @@
+#ifndef ENGINE_DIFF_PICO_STDLIB_H
+#define ENGINE_DIFF_PICO_STDLIB_H
+
+// Só o que o motor do jogo (e input.c/remote.c) usa do Pico SDK, para
+// compilar no host (tools/engine_diff.py). Nada aqui toca hardware.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef unsigned int uint;
+
+void panic(const char *fmt, ...);
+
+// O amostrador do joystick nunca dispara no host: as curvas chegam pelo adaptador
+typedef struct repeating_timer {
+    void *user_data;
+} repeating_timer_t;
+
+typedef bool (*repeating_timer_callback_t)(repeating_timer_t *rt);
+
+bool add_repeating_timer_ms(int32_t delay_ms, repeating_timer_callback_t callback, void *user_data,
+                            repeating_timer_t *out);
+bool cancel_repeating_timer(repeating_timer_t *timer);
+uint32_t time_us_32(void);
+
+#endif // ENGINE_DIFF_PICO_STDLIB_H
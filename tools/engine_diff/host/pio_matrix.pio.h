@@ -0,0 +1,6 @@
+#ifndef ENGINE_DIFF_PIO_MATRIX_PIO_H
+#define ENGINE_DIFF_PIO_MATRIX_PIO_H
+
+// No firmware, gerado pelo pioasm; o motor não usa o programa da PIO
+
+#endif // ENGINE_DIFF_PIO_MATRIX_PIO_H
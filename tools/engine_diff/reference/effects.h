@@ -0,0 +1,46 @@
+#ifndef EFFECTS_H
+#define EFFECTS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pico/stdlib.h"
+#include "matriz_led_control.h"
+
+// Motor de efeitos de LED: animações por quadros-chave avançadas por um timer
+// repetitivo, que só fica ativo enquanto houver algum efeito tocando. O jogo
+// dispara um efeito e segue; efeitos simultâneos são compostos pelo máximo
+// (brilho do LED azul e cada canal de cada pixel da matriz).
+
+#define EFFECTS_TICK_MS 10
+#define EFFECTS_MAX 4          // Efeitos simultâneos
+#define EFFECTS_FOREVER 0      // 'repeat' = 0: repete até ser cancelado
+
+// Quadro-chave do LED azul: brilho (0-255) no instante t_ms; interpolação linear
+typedef struct {
+    uint16_t t_ms;
+    uint8_t level;
+} effect_key_t;
+
+// Quadro da matriz 5x5: intensidades (0-255, mesma ordem de desenho_pio) e cor.
+// pixels = NULL apaga a matriz durante o quadro.
+typedef struct {
+    const uint8_t *pixels;
+    uint8_t r, g, b;
+    uint16_t duration_ms;
+} effect_frame_t;
+
+// Identificador de um efeito disparado; 0 = nenhum
+typedef uint16_t effect_t;
+
+void effects_init(pio_t *led_matrix, uint led_gpio);
+
+// Disparam o efeito e retornam imediatamente (0 se não houver espaço livre).
+// Os arrays precisam continuar válidos enquanto o efeito toca (const na flash).
+effect_t effects_led_fade(const effect_key_t *keys, uint8_t count, uint8_t repeat);
+effect_t effects_matrix_play(const effect_frame_t *frames, uint8_t count, uint8_t repeat);
+
+void effects_cancel(effect_t effect);
+void effects_cancel_all(void);
+bool effects_is_running(effect_t effect);
+
+#endif // EFFECTS_H
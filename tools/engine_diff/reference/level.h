@@ -0,0 +1,34 @@
+#ifndef LEVEL_H
+#define LEVEL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "world.h"
+
+// Formato dos níveis: cada nível é um blob const gerado por tools/level_compile.py
+// a partir de assets/levels/*.lvl. Os blobs ficam na flash e o jogo lê direto
+// deles pela XIP (só guarda um ponteiro), sem copiar o mapa para a RAM.
+
+#define LEVEL_NAME_MAX 12
+#define LEVEL_FLAG_WRAP 0x01       // Bordas teletransportam; sem a flag, são paredes
+
+typedef struct {
+    uint8_t x;
+    uint8_t y;
+    uint8_t dir;                   // Direction da cobra ao nascer
+} level_spawn_t;
+
+typedef struct {
+    char name[LEVEL_NAME_MAX];
+    level_spawn_t spawn[2];        // Jogador 1 e jogador 2 (versus)
+    uint8_t flags;
+    uint8_t target;                // Comidas para passar de nível; 0 = sem fim
+    uint8_t walls[WORLD_ROWS][WORLD_COLS / 8];  // 1 bit por célula, MSB = coluna menor
+} level_t;
+
+// Célula (x, y) é obstáculo? Uma leitura de byte na flash.
+static inline bool level_wall(const level_t *level, uint8_t x, uint8_t y) {
+    return (level->walls[y][x >> 3] & (0x80 >> (x & 7))) != 0;
+}
+
+#endif // LEVEL_H
@@ -0,0 +1,543 @@
+#include "snake.h"
+#include "pico/stdlib.h"
+#include <stdlib.h>
+#include <string.h>
+#include "hardware/pwm.h"
+#include "input.h"
+#include "telemetry.h"
+#include "effects.h"
+#include "logger.h"
+#include "levels.h"
+#include "sprites.h"
+
+// Peças das cobras, alimento e obstáculos vêm do atlas gerado de assets/sprites
+// (tools/sprite_compile.py), já em todas as orientações.
+_Static_assert(SPRITE_SETS >= SNAKE_MAX_PLAYERS, "falta um conjunto de sprites por jogador");
+_Static_assert(CELL_SIZE == 8, "os sprites são de 8x8");
+
+// -------------------------------------------------------------------
+// Efeitos de LED (tocados pelo motor de efeitos, sem bloquear o jogo)
+
+// LED azul: acende ao pegar a comida e apaga suavemente em 200 ms
+static const effect_key_t food_eaten_keys[] = {
+    {0, 255}, {80, 255}, {200, 0}
+};
+
+// Padrão de X para a animação de Game Over (formato 5x5), constante na flash
+static const uint8_t x_pattern[NUM_PIXELS] = {
+    255,   0,   0,   0, 255,
+      0, 255,   0, 255,   0,
+      0,   0, 255,   0,   0,
+      0, 255,   0, 255,   0,
+    255,   0,   0,   0, 255
+};
+
+static const effect_frame_t game_over_frames[] = {
+    {x_pattern, 255, 0, 0, 500},  // X vermelho aceso
+    {NULL,        0, 0, 0, 500}   // Matriz apagada
+};
+
+static effect_t game_over_effect = 0;
+
+// -------------------------------------------------------------------
+// Funções internas para controle do jogo
+
+// Conteúdo da célula: obstáculos do nível (bitmap na flash) ou ocupação das cobras.
+// Colisões e sorteio da comida passam por aqui, então os obstáculos não custam
+// nenhuma passada extra por tick.
+static inline uint8_t snake_cell(const SnakeGame *game, Position pos) {
+    if (level_wall(game->level, pos.x, pos.y))
+        return SNAKE_CELL_WALL;
+    return world_get(&game->world, pos.x, pos.y);
+}
+
+static inline bool snake_level_wraps(const SnakeGame *game) {
+    return (game->level->flags & LEVEL_FLAG_WRAP) != 0;
+}
+
+// O passo na direção 'dir' atravessa a borda do mundo?
+static inline bool snake_crosses_edge(Position pos, Direction dir) {
+    return (dir == RIGHT && pos.x == WORLD_COLS - 1) || (dir == LEFT && pos.x == 0) ||
+           (dir == DOWN && pos.y == WORLD_ROWS - 1) || (dir == UP && pos.y == 0);
+}
+
+static inline bool snake_set_cell(SnakeGame *game, Position pos, uint8_t value) {
+    return world_set(&game->world, pos.x, pos.y, value);
+}
+
+// Posição vizinha na direção informada, com wrap-around nas bordas do mundo.
+static Position snake_step(Position pos, Direction dir) {
+    if (dir == RIGHT)
+        pos.x = (pos.x + 1 == WORLD_COLS) ? 0 : pos.x + 1;
+    else if (dir == DOWN)
+        pos.y = (pos.y + 1 == WORLD_ROWS) ? 0 : pos.y + 1;
+    else if (dir == LEFT)
+        pos.x = pos.x ? pos.x - 1 : WORLD_COLS - 1;
+    else if (dir == UP)
+        pos.y = pos.y ? pos.y - 1 : WORLD_ROWS - 1;
+    return pos;
+}
+
+// Coordenada 'a + delta' com wrap-around em um eixo de tamanho 'size'
+static inline uint8_t snake_wrap(int a, int delta, int size) {
+    int v = (a + delta) % size;
+    return (uint8_t)(v < 0 ? v + size : v);
+}
+
+// Distância com sinal de 'from' até 'to' pelo caminho mais curto (wrap-around)
+static inline int snake_delta(int from, int to, int size) {
+    int d = (to - from) % size;
+    if (d < 0) d += size;
+    return d >= size / 2 ? d - size : d;
+}
+
+// Mesma distância, sem atravessar as bordas quando o nível não tem wrap-around
+static inline int snake_level_delta(const SnakeGame *game, int from, int to, int size) {
+    return snake_level_wraps(game) ? snake_delta(from, to, size) : to - from;
+}
+
+// Gera uma posição aleatória para a comida, evitando as células ocupadas.
+// Em mundos maiores que a tela, a comida aparece a no máximo uma tela de
+// distância do jogador 1, para que ele consiga encontrá-la.
+static void snake_generate_food(SnakeGame *game) {
+    Position head = snake_head(&game->snakes[0]);
+    Position pos;
+    do {
+        if (WORLD_COLS > 2 * GRID_COLS)
+            pos.x = snake_wrap(head.x, rand() % (2 * GRID_COLS + 1) - GRID_COLS, WORLD_COLS);
+        else
+            pos.x = rand() % WORLD_COLS;
+        if (WORLD_ROWS > 2 * GRID_ROWS)
+            pos.y = snake_wrap(head.y, rand() % (2 * GRID_ROWS + 1) - GRID_ROWS, WORLD_ROWS);
+        else
+            pos.y = rand() % WORLD_ROWS;
+    } while (snake_cell(game, pos) != SNAKE_CELL_EMPTY);
+    game->food = pos;
+}
+
+// Coloca uma cobra de 3 segmentos no ponto de nascimento do nível
+// (a posição já foi validada por tools/level_compile.py).
+static void snake_spawn(SnakeGame *game, uint8_t id, const level_spawn_t *spawn) {
+    Direction dir = (Direction)spawn->dir;
+    Snake *snake = &game->snakes[id];
+    snake->head = 0;
+    snake->length = 3;
+    snake->direction = dir;
+    snake->next_direction = dir;
+    snake->alive = true;
+    snake->score = 0;  // Inicializa a pontuação
+    Position pos = {spawn->x, spawn->y};
+    Direction back = (Direction)((dir + 2) % 4);
+    for (uint8_t i = 0; i < snake->length; i++) {
+        snake->body[i] = pos;
+        snake_set_cell(game, pos, id + 1);
+        pos = snake_step(pos, back);
+    }
+    snake->tail_prev = snake_segment(snake, snake->length - 1);
+}
+
+// Remove o corpo de uma cobra morta da grade (só acontece uma vez por cobra).
+static void snake_remove(SnakeGame *game, uint8_t id) {
+    Snake *snake = &game->snakes[id];
+    for (uint8_t i = 0; i < snake->length; i++)
+        snake_set_cell(game, snake_segment(snake, i), SNAKE_CELL_EMPTY);
+    snake->alive = false;
+}
+
+// Indica se alguma célula vizinha de 'pos' é a cabeça de outra cobra.
+static bool snake_near_other_head(SnakeGame *game, const Snake *self, Position pos) {
+    for (int dir = 0; dir < 4; dir++) {
+        Position n = snake_step(pos, (Direction)dir);
+        uint8_t owner = snake_cell(game, n);
+        if (owner == SNAKE_CELL_EMPTY || owner == SNAKE_CELL_WALL)
+            continue;
+        const Snake *other = &game->snakes[owner - 1];
+        Position head = snake_head(other);
+        if (other != self && head.x == n.x && head.y == n.y)
+            return true;
+    }
+    return false;
+}
+
+// Autopiloto: entre seguir em frente e virar, escolhe a célula livre mais perto
+// da comida, evitando obstáculos, bordas sem wrap-around e disputar uma célula
+// com outra cabeça. Só consulta a grade: O(1) por tick.
+static Direction snake_autopilot(SnakeGame *game, const Snake *snake) {
+    Position head = snake_head(snake);
+    Direction best = snake->direction;
+    int best_cost = 1 << 30;
+    for (int turn = 0; turn < 3; turn++) {
+        // Ordem: em frente, direita, esquerda (nunca a reversa)
+        Direction dir = (Direction)((snake->direction + (turn == 2 ? 3 : turn)) % 4);
+        Position next = snake_step(head, dir);
+        int dx = abs(snake_level_delta(game, next.x, game->food.x, WORLD_COLS));
+        int dy = abs(snake_level_delta(game, next.y, game->food.y, WORLD_ROWS));
+        int cost = dx + dy;
+        if (!snake_level_wraps(game) && snake_crosses_edge(head, dir))
+            cost += WORLD_COLS * WORLD_ROWS;
+        else if (snake_cell(game, next) != SNAKE_CELL_EMPTY)
+            cost += WORLD_COLS * WORLD_ROWS;
+        else if (snake_near_other_head(game, snake, next))
+            cost += 2;  // Risco de bater de frente com outra cabeça
+        if (cost < best_cost) {
+            best_cost = cost;
+            best = dir;
+        }
+    }
+    return best;
+}
+
+// Inicializa o estado do jogo.
+void snake_init(SnakeGame *game) {
+    world_clear(&game->world);
+    game->level = &levels[game->level_index];
+    game->level_eaten = 0;
+    game->level_complete = false;
+
+    // Cada cobra nasce no ponto definido pelo nível
+    for (uint8_t id = 0; id < game->num_snakes; id++)
+        snake_spawn(game, id, &game->level->spawn[id]);
+    // Jogador 1 no joystick; as demais começam no autopiloto (a serial assume com i/j/k/l)
+    game->snakes[0].control = SNAKE_CTRL_JOYSTICK;
+    for (uint8_t id = 1; id < SNAKE_MAX_PLAYERS; id++) {
+        game->snakes[id].control = SNAKE_CTRL_AUTOPILOT;
+        game->snakes[id].alive = (id < game->num_snakes);
+    }
+
+    game->stepped = false;
+    game->game_over_flag = false;
+    game->winner = -1;
+    effects_cancel(game_over_effect);
+    game_over_effect = 0;
+    input_reset(game->snakes[0].direction);
+    snake_generate_food(game);
+}
+
+void snake_set_level(SnakeGame *game, uint8_t index) {
+    game->level_index = index % LEVEL_COUNT;
+}
+
+void snake_next_level(SnakeGame *game) {
+    int scores[SNAKE_MAX_PLAYERS];
+    for (uint8_t id = 0; id < SNAKE_MAX_PLAYERS; id++)
+        scores[id] = game->snakes[id].score;
+    snake_set_level(game, game->level_index + 1);
+    snake_init(game);
+    for (uint8_t id = 0; id < game->num_snakes; id++)
+        game->snakes[id].score = scores[id];
+    LOG_INFO("snake: nivel %u (%s)\n", game->level_index + 1, game->level->name);
+}
+
+// Número de cobras a partir do próximo snake_init (chamar antes do primeiro).
+void snake_set_players(SnakeGame *game, uint8_t players) {
+    if (players < 1)
+        players = 1;
+    if (players > SNAKE_MAX_PLAYERS)
+        players = SNAKE_MAX_PLAYERS;
+    game->num_snakes = players;
+}
+
+void snake_set_control(SnakeGame *game, uint8_t id, SnakeControl control) {
+    if (id < SNAKE_MAX_PLAYERS)
+        game->snakes[id].control = control;
+}
+
+void snake_request_turn(SnakeGame *game, uint8_t id, Direction dir) {
+    if (id >= game->num_snakes)
+        return;
+    Snake *snake = &game->snakes[id];
+    if (snake->control == SNAKE_CTRL_AUTOPILOT)
+        snake->control = SNAKE_CTRL_SERIAL;  // A primeira tecla assume o controle
+    snake->next_direction = dir;
+}
+
+// Aplica no máximo uma curva por tick para cada cobra. A do joystick vem da fila
+// do amostrador de entrada, que já descarta reversões em relação à curva anterior;
+// a checagem abaixo só protege contra a direção atual.
+void snake_update_direction(SnakeGame *game) {
+    for (uint8_t id = 0; id < game->num_snakes; id++) {
+        Snake *snake = &game->snakes[id];
+        if (!snake->alive)
+            continue;
+        Direction dir = snake->direction;
+        if (snake->control == SNAKE_CTRL_JOYSTICK) {
+            input_turn_t turn;
+            if (input_pop_turn(&turn))
+                dir = turn.dir;
+        } else if (snake->control == SNAKE_CTRL_SERIAL) {
+            dir = snake->next_direction;
+        } else {
+            dir = snake_autopilot(game, snake);
+        }
+        if (dir != (Direction)((snake->direction + 2) % 4))
+            snake->direction = dir;
+    }
+}
+
+// Atualiza o estado do jogo: movimenta as cobras, trata alimentação, wrap-around e colisões.
+// Cada cobra custa O(1) por tick: as colisões são consultas à grade de ocupação.
+// A marca de chegada da cabeça fica na célula e vira o dono no movimento, então uma
+// sobrevivente nunca precisa de um bloco novo do mundo depois da 1ª fase.
+void snake_update(SnakeGame *game, pio_t *led_matrix) 
+{
+    Position new_head[SNAKE_MAX_PLAYERS];
+    bool dead[SNAKE_MAX_PLAYERS] = {false};
+
+    // 1ª fase: destino de cada cabeça. Qualquer célula ocupada (inclusive a cauda,
+    // que ainda não saiu) e obstáculo é colisão; duas cabeças no mesmo destino
+    // morrem juntas. Sem wrap-around, atravessar a borda também mata.
+    bool claimed[SNAKE_MAX_PLAYERS] = {false};
+    for (uint8_t id = 0; id < game->num_snakes; id++) {
+        Snake *snake = &game->snakes[id];
+        if (!snake->alive)
+            continue;
+        new_head[id] = snake_step(snake_head(snake), snake->direction);
+        uint8_t cell = snake_cell(game, new_head[id]);
+        if (!snake_level_wraps(game) && snake_crosses_edge(snake_head(snake), snake->direction)) {
+            dead[id] = true;
+        } else if (cell & SNAKE_CELL_CLAIM) {
+            dead[id] = true;
+            dead[(cell & ~SNAKE_CELL_CLAIM) - 1] = true;
+        } else if (cell != SNAKE_CELL_EMPTY) {
+            dead[id] = true;
+        } else if (snake_set_cell(game, new_head[id], SNAKE_CELL_CLAIM | (id + 1))) {
+            claimed[id] = true;
+        } else {
+            // Pool de blocos esgotado: tratado como colisão
+            LOG_WARN("snake: sem blocos livres no mundo\n");
+            dead[id] = true;
+        }
+    }
+    // Marcas das cobras que morrem saem antes de remover os corpos
+    for (uint8_t id = 0; id < game->num_snakes; id++) {
+        if (claimed[id] && dead[id])
+            snake_set_cell(game, new_head[id], SNAKE_CELL_EMPTY);
+    }
+
+    // 2ª fase: move as sobreviventes
+    uint8_t alive = 0;
+    for (uint8_t id = 0; id < game->num_snakes; id++) {
+        Snake *snake = &game->snakes[id];
+        if (!snake->alive)
+            continue;
+        if (dead[id]) {
+            snake_remove(game, id);
+            continue;
+        }
+        alive++;
+
+        bool ate_food = (new_head[id].x == game->food.x && new_head[id].y == game->food.y);
+        snake->tail_prev = snake_segment(snake, snake->length - 1);
+        if (ate_food && snake->length < MAX_SNAKE_LENGTH) {
+            snake->length++;
+        } else {
+            // A cauda libera a célula
+            snake_set_cell(game, snake->tail_prev, SNAKE_CELL_EMPTY);
+        }
+        snake->head = (snake->head + MAX_SNAKE_LENGTH - 1) % MAX_SNAKE_LENGTH;
+        snake->body[snake->head] = new_head[id];
+        snake_set_cell(game, new_head[id], id + 1);  // A marca vira o dono
+
+        if (ate_food) {
+            snake->score++;  // Incrementa a pontuação
+            uint8_t food[2] = {(uint8_t)new_head[id].x, (uint8_t)new_head[id].y};
+            telemetry_event(TLM_EVENT_FOOD, food, sizeof(food));
+            if (id == 0) {
+                game->level_eaten++;
+                if (game->level->target && game->level_eaten >= game->level->target)
+                    game->level_complete = true;
+                uint8_t score[2] = {snake->score & 0xFF, (snake->score >> 8) & 0xFF};
+                telemetry_event(TLM_EVENT_SCORE, score, sizeof(score));
+                food_eaten_animation();
+            }
+            snake_generate_food(game);
+        }
+    }
+
+    game->stepped = true;
+
+    // Fim de jogo: o jogador 1 morreu ou, no versus, sobrou no máximo uma cobra
+    if (!game->snakes[0].alive || (game->num_snakes > 1 && alive <= 1)) {
+        game->game_over_flag = true;
+        game->winner = -1;
+        for (uint8_t id = 0; id < game->num_snakes && alive == 1; id++) {
+            if (game->snakes[id].alive)
+                game->winner = id;
+        }
+    }
+}
+// -------------------------------------------------------------------
+// Funções de desenho com o novo design
+
+// Direção de um segmento até o vizinho 'to' no corpo (com wrap-around)
+static inline Direction snake_neighbor_dir(Position from, Position to) {
+    if (from.y == to.y)
+        return to.x == snake_wrap(from.x, 1, WORLD_COLS) ? RIGHT : LEFT;
+    return to.y == snake_wrap(from.y, 1, WORLD_ROWS) ? DOWN : UP;
+}
+
+// Peça do segmento i: cabeça e cauda pela direção em que andam, o meio pela
+// tabela de vizinhos (reto ou curva).
+static uint8_t snake_tile(const Snake *snake, uint8_t i) {
+    Position pos = snake_segment(snake, i);
+    if (i == 0) {
+        Direction facing = snake->length > 1 ? snake_neighbor_dir(snake_segment(snake, 1), pos) : snake->direction;
+        return SPRITE_HEAD + facing;
+    }
+    Direction front = snake_neighbor_dir(pos, snake_segment(snake, i - 1));
+    if (i == snake->length - 1)
+        return SPRITE_TAIL + front;
+    return sprite_segment[front][snake_neighbor_dir(pos, snake_segment(snake, i + 1))];
+}
+
+// Tamanhos do mundo e da janela visível em pixels
+#define WORLD_PX_W (WORLD_COLS * CELL_SIZE)
+#define WORLD_PX_H (WORLD_ROWS * CELL_SIZE)
+#define VIEW_PX_W (GRID_COLS * CELL_SIZE)
+#define VIEW_PX_H (GRID_ROWS * CELL_SIZE)
+
+static inline int snake_wrap_px(int v, int size) {
+    v %= size;
+    return v < 0 ? v + size : v;
+}
+
+// Posição em pixels de uma peça que sai da célula 'from' para a vizinha 'to'
+// e já andou 'step' pixels.
+static void snake_piece_px(Position from, Position to, uint8_t step, int *x, int *y) {
+    Direction dir = snake_neighbor_dir(from, to);
+    *x = from.x * CELL_SIZE + (dir == RIGHT ? step : (dir == LEFT ? -step : 0));
+    *y = from.y * CELL_SIZE + (dir == DOWN ? step : (dir == UP ? -step : 0));
+}
+
+// Sprite na posição (x, y) do mundo, em pixels. Uma peça atravessando a borda
+// do mundo (wrap-around) aparece dos dois lados, então a parte que passou da
+// borda é desenhada de novo do outro lado; o recorte fica com o driver.
+static void snake_blit(const SnakeGame *game, ssd1306_t *display, int x, int y, const uint8_t *sprite) {
+    int sx = snake_wrap_px(x - game->camera_x, WORLD_PX_W);
+    int sy = snake_wrap_px(y - game->camera_y, WORLD_PX_H);
+    bool wrap_x = sx > WORLD_PX_W - CELL_SIZE;
+    bool wrap_y = sy > WORLD_PX_H - CELL_SIZE;
+    ssd1306_draw_bitmap(display, sx, sy, sprite);
+    if (wrap_x)
+        ssd1306_draw_bitmap(display, sx - WORLD_PX_W, sy, sprite);
+    if (wrap_y)
+        ssd1306_draw_bitmap(display, sx, sy - WORLD_PX_H, sprite);
+    if (wrap_x && wrap_y)
+        ssd1306_draw_bitmap(display, sx - WORLD_PX_W, sy - WORLD_PX_H, sprite);
+}
+
+// Câmera em um eixo, em pixels: a cabeça fica no centro; sem wrap-around, a
+// janela para nas bordas do mundo.
+static int16_t snake_camera_axis(const SnakeGame *game, int head, int view, int size) {
+    if (size <= view)
+        return 0;
+    if (snake_level_wraps(game))
+        return snake_wrap_px(head - view / 2, size);
+    int c = head - view / 2;
+    return (int16_t)(c < 0 ? 0 : (c > size - view ? size - view : c));
+}
+
+// Uma cobra: o meio nas células do último tick; a cauda sai da célula que
+// deixou e a cabeça entra na nova, 'step' pixels cada. A célula da cauda
+// ganha a peça do meio que ela tinha antes, coberta aos poucos pela cauda.
+static void snake_draw_snake(const SnakeGame *game, ssd1306_t *display, uint8_t id, uint8_t step) {
+    const Snake *snake = &game->snakes[id];
+    const uint8_t (*tiles)[8] = sprite_snake[id];
+    uint8_t last = snake->length - 1;
+    for (uint8_t i = 1; i < last; i++) {
+        Position pos = snake_segment(snake, i);
+        snake_blit(game, display, pos.x * CELL_SIZE, pos.y * CELL_SIZE, tiles[snake_tile(snake, i)]);
+    }
+
+    Position tail = snake_segment(snake, last);
+    int x, y;
+    if (game->stepped && (snake->tail_prev.x != tail.x || snake->tail_prev.y != tail.y)) {
+        Position front = snake_segment(snake, last - 1);
+        uint8_t middle = sprite_segment[snake_neighbor_dir(tail, front)][snake_neighbor_dir(tail, snake->tail_prev)];
+        snake_blit(game, display, tail.x * CELL_SIZE, tail.y * CELL_SIZE, tiles[middle]);
+        snake_piece_px(snake->tail_prev, tail, step, &x, &y);
+        snake_blit(game, display, x, y, tiles[SPRITE_TAIL + snake_neighbor_dir(snake->tail_prev, tail)]);
+    } else {
+        snake_blit(game, display, tail.x * CELL_SIZE, tail.y * CELL_SIZE, tiles[snake_tile(snake, last)]);
+    }
+
+    snake_piece_px(snake_segment(snake, 1), snake_head(snake), step, &x, &y);
+    snake_blit(game, display, x, y, tiles[snake_tile(snake, 0)]);
+}
+
+// Desenha o estado atual do jogo com o atlas de sprites. Os obstáculos saem da
+// janela visível do nível; os segmentos, do corpo de cada cobra, que dá os
+// vizinhos para escolher a peça (o driver recorta o que cai fora da tela).
+// A câmera acompanha a cabeça interpolada do jogador 1, então nos mundos
+// maiores que a tela ela também rola pixel a pixel.
+void snake_draw(SnakeGame *game, ssd1306_t *display, uint8_t step_px) {
+    if (step_px > CELL_SIZE || !game->stepped)
+        step_px = CELL_SIZE;
+    ssd1306_fill(display, 0);
+
+    int hx, hy;
+    const Snake *p1 = &game->snakes[0];
+    snake_piece_px(snake_segment(p1, 1), snake_head(p1), step_px, &hx, &hy);
+    game->camera_x = snake_camera_axis(game, snake_wrap_px(hx, WORLD_PX_W), VIEW_PX_W, WORLD_PX_W);
+    game->camera_y = snake_camera_axis(game, snake_wrap_px(hy, WORLD_PX_H), VIEW_PX_H, WORLD_PX_H);
+
+    // Uma linha/coluna a mais quando a câmera está entre duas células
+    uint8_t first_col = game->camera_x / CELL_SIZE, first_row = game->camera_y / CELL_SIZE;
+    uint8_t cols = GRID_COLS + (game->camera_x % CELL_SIZE != 0);
+    uint8_t rows = GRID_ROWS + (game->camera_y % CELL_SIZE != 0);
+    for (uint8_t row = 0; row < rows; row++) {
+        uint8_t y = snake_wrap(first_row, row, WORLD_ROWS);
+        for (uint8_t col = 0; col < cols; col++) {
+            uint8_t x = snake_wrap(first_col, col, WORLD_COLS);
+            if (level_wall(game->level, x, y))
+                snake_blit(game, display, x * CELL_SIZE, y * CELL_SIZE, sprite_wall);
+        }
+    }
+
+    for (uint8_t id = 0; id < game->num_snakes; id++) {
+        if (game->snakes[id].alive)
+            snake_draw_snake(game, display, id, step_px);
+    }
+
+    // Alimento: desenhado se estiver na janela; senão, um ponto na borda da
+    // tela indica a direção em que ele está.
+    int food_x = snake_level_delta(game, game->camera_x + VIEW_PX_W / 2, game->food.x * CELL_SIZE, WORLD_PX_W) + VIEW_PX_W / 2;
+    int food_y = snake_level_delta(game, game->camera_y + VIEW_PX_H / 2, game->food.y * CELL_SIZE, WORLD_PX_H) + VIEW_PX_H / 2;
+    if (food_x > -CELL_SIZE && food_x < VIEW_PX_W && food_y > -CELL_SIZE && food_y < VIEW_PX_H) {
+        ssd1306_draw_bitmap(display, food_x, food_y, sprite_food);
+    } else {
+        int px = food_x + CELL_SIZE / 2;
+        int py = food_y + CELL_SIZE / 2;
+        px = px < 0 ? 0 : (px > VIEW_PX_W - 2 ? VIEW_PX_W - 2 : px);
+        py = py < 0 ? 0 : (py > VIEW_PX_H - 2 ? VIEW_PX_H - 2 : py);
+        ssd1306_rect(display, py, px, 2, 2, true, true);
+    }
+
+    ssd1306_send_data(display);
+}
+
+// -------------------------------------------------------------------
+// Tela de "Game Over" e animação de LED (mantidas da base)
+
+void snake_game_over_screen(SnakeGame *game, ssd1306_t *display, pio_t *led_matrix) {
+    ssd1306_fill(display, 0);
+    ssd1306_draw_string(display, "GAME OVER", 20, SSD1306_SCALE_Y(10));
+    if (game->num_snakes > 1) {
+        // Versus: mostra o resultado da rodada
+        if (game->winner < 0)
+            ssd1306_draw_string(display, "EMPATE", 20, SSD1306_SCALE_Y(25));
+        else
+            ssd1306_draw_string(display, game->winner == 0 ? "P1 VENCEU" : "P2 VENCEU", 20, SSD1306_SCALE_Y(25));
+    }
+    ssd1306_draw_string(display, "Press BTN", 20, SSD1306_SCALE_Y(40));
+    ssd1306_send_data(display);
+    
+    // Pisca o X vermelho na matriz de LEDs (5 vezes, 500 ms aceso / 500 ms apagado)
+    // pelo motor de efeitos; a espera pelo botão fica com a máquina de estados (ui.c)
+    effects_cancel(game_over_effect);
+    game_over_effect = effects_matrix_play(game_over_frames, 2, 5);
+}
+//pisca o led azul quando a cobra pega a comida
+void food_eaten_animation() {
+    effects_led_fade(food_eaten_keys, sizeof(food_eaten_keys) / sizeof(food_eaten_keys[0]), 1);
+}
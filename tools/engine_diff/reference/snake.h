@@ -0,0 +1,139 @@
+#ifndef SNAKE_H
+#define SNAKE_H
+
+// Se ainda não estiver definida, define o pino do botão do joystick
+#ifndef JOYSTICK_BTN
+#define JOYSTICK_BTN 22
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "ssd1306.h"           // Certifique-se de que esta biblioteca esteja disponível
+#include "matriz_led_control.h"
+#include "world.h"
+#include "level.h"
+
+// Janela visível do mundo (células na tela) e parâmetros do jogo; a altura
+// segue o painel (16x8 no de 64 linhas, 16x4 no de 32)
+#define CELL_SIZE 8
+#define GRID_COLS (SSD1306_WIDTH / CELL_SIZE)
+#define GRID_ROWS (SSD1306_HEIGHT / CELL_SIZE)
+// Comprimento máximo: o tabuleiro inteiro no mundo do tamanho da tela,
+// limitado a 128 segmentos em mundos maiores
+#define MAX_SNAKE_LENGTH (WORLD_COLS * WORLD_ROWS < 128 ? WORLD_COLS * WORLD_ROWS : 128)
+
+#if WORLD_COLS < GRID_COLS || WORLD_ROWS < GRID_ROWS
+#error "O mundo não pode ser menor que a tela"
+#endif
+
+// Parâmetros do joystick (DEAD_ZONE e NUM_SAMPLES são padrões de config.h)
+#define JOYSTICK_X_ADC 0
+#define JOYSTICK_Y_ADC 1
+#define JOYSTICK_CENTER 2048
+#define DEAD_ZONE 100
+#define NUM_SAMPLES 10
+
+#define LED_B_PIN 12  // Pino do LED azul
+
+// Parâmetro do delay entre frames (em milissegundos; padrão de config.frame_delay_ms)
+#define FRAME_DELAY 300
+
+// Telas por segundo entre os ticks, com cabeça e cauda interpoladas
+// (padrão de config.render_fps; 0 = tela só nos ticks)
+#ifndef RENDER_FPS
+#define RENDER_FPS 60
+#endif
+
+// Estrutura para representar uma posição no mundo
+typedef struct {
+    uint8_t x;
+    uint8_t y;
+} Position;
+
+// Enumeração para as direções
+typedef enum {
+    RIGHT = 0,
+    DOWN,
+    LEFT,
+    UP
+} Direction;
+
+// Modo versus: número máximo de cobras e quantas jogam desde o boot
+// (CMake: -DSNAKE_VERSUS=ON)
+#define SNAKE_MAX_PLAYERS 2
+#ifndef SNAKE_VERSUS_AT_BOOT
+#define SNAKE_VERSUS_AT_BOOT 0
+#endif
+
+// Conteúdo de uma célula da grade de ocupação (world_t)
+#define SNAKE_CELL_EMPTY 0        // Livre; 1..SNAKE_MAX_PLAYERS = dono (id + 1)
+#define SNAKE_CELL_CLAIM 0x80     // Marca temporária: cabeça chegando neste tick
+#define SNAKE_CELL_WALL 0x40      // Obstáculo do nível (lido da flash, nunca gravado)
+
+// Quem controla cada cobra
+typedef enum {
+    SNAKE_CTRL_JOYSTICK = 0,  // Fila de curvas do amostrador (input.c)
+    SNAKE_CTRL_SERIAL,        // Teclas i/j/k/l pela serial/USB
+    SNAKE_CTRL_AUTOPILOT      // Vai em direção à comida evitando células ocupadas
+} SnakeControl;
+
+// Uma cobra: corpo em buffer circular (a cabeça anda para trás no buffer,
+// então mover custa O(1), sem deslocar os segmentos)
+typedef struct {
+    Position body[MAX_SNAKE_LENGTH];
+    uint8_t head;          // Índice da cabeça em body
+    uint8_t length;
+    Direction direction;
+    Direction next_direction;  // Curva pedida pela serial/autopiloto
+    Position tail_prev;    // Célula deixada pela cauda no último tick (= cauda se cresceu)
+    SnakeControl control;
+    bool alive;
+    int score;
+} Snake;
+
+// Estrutura que encapsula o estado do jogo
+typedef struct {
+    Snake snakes[SNAKE_MAX_PLAYERS];
+    uint8_t num_snakes;
+    world_t world;         // Ocupação compartilhada por todas as cobras
+    Position food;
+    int16_t camera_x;      // Canto superior esquerdo da janela visível, em pixels do mundo
+    int16_t camera_y;
+    const level_t *level;  // Nível atual, lido direto da flash
+    uint8_t level_index;
+    uint8_t level_eaten;   // Comidas do jogador 1 neste nível
+    bool level_complete;   // Alvo do nível atingido (a UI passa para o próximo)
+    bool stepped;          // Já houve um tick desde snake_init (há movimento para interpolar)
+    bool game_over_flag;
+    int8_t winner;         // Modo versus: id da vencedora, -1 = empate
+} SnakeGame;
+
+// i-ésimo segmento (0 = cabeça)
+static inline Position snake_segment(const Snake *snake, uint8_t i) {
+    return snake->body[(snake->head + i) % MAX_SNAKE_LENGTH];
+}
+
+static inline Position snake_head(const Snake *snake) {
+    return snake->body[snake->head];
+}
+
+// Protótipos das funções públicas da biblioteca
+void snake_init(SnakeGame *game);
+void snake_set_players(SnakeGame *game, uint8_t players);
+// Nível usado a partir do próximo snake_init (índice em levels[], com volta)
+void snake_set_level(SnakeGame *game, uint8_t index);
+// Passa para o próximo nível mantendo as pontuações
+void snake_next_level(SnakeGame *game);
+void snake_set_control(SnakeGame *game, uint8_t id, SnakeControl control);
+// Curva pedida para uma cobra controlada pela serial (aplicada no próximo tick)
+void snake_request_turn(SnakeGame *game, uint8_t id, Direction dir);
+void snake_update_direction(SnakeGame *game);
+void snake_update(SnakeGame *game, pio_t *led_matrix);
+// Desenha o jogo com cabeças e caudas 'step_px' pixels (0..CELL_SIZE) adiante
+// da posição do último tick, em direção à posição atual: chamado entre ticks
+// com frações crescentes, a tela anda pixel a pixel.
+void snake_draw(SnakeGame *game, ssd1306_t *display, uint8_t step_px);
+void snake_game_over_screen(SnakeGame *game, ssd1306_t *display, pio_t *led_matrix);
+void food_eaten_animation();
+
+#endif // SNAKE_H
@@ -0,0 +1,327 @@
+#include "ssd1306.h"
+#include "font.h"
+#include <string.h>
+
+#define SSD1306_STATIC_FRAMEBUFFER (SNAKE_NO_HEAP || !SSD1306_RUNTIME_GEOMETRY)
+
+#if SSD1306_STATIC_FRAMEBUFFER
+static uint8_t ssd1306_static_buffer[SSD1306_STATIC_BUFSIZE];
+static uint8_t ssd1306_static_shadow[SSD1306_STATIC_BUFSIZE - 1];
+static bool ssd1306_static_buffer_used = false;
+#endif
+
+void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c) {
+#if !SSD1306_RUNTIME_GEOMETRY
+  if (width != SSD1306_WIDTH || height != SSD1306_HEIGHT)
+    panic("ssd1306: painel %ux%u, mas o build e para %ux%u", width, height, SSD1306_WIDTH, SSD1306_HEIGHT);
+#endif
+  ssd->width = width;
+  ssd->height = height;
+  ssd->pages = height / 8U;
+  ssd->address = address;
+  ssd->i2c_port = i2c;
+  ssd->bufsize = ssd->pages * ssd->width + 1;
+#if SSD1306_STATIC_FRAMEBUFFER
+  if (ssd->bufsize > SSD1306_STATIC_BUFSIZE || ssd1306_static_buffer_used)
+    panic("ssd1306: framebuffer estatico insuficiente");
+  ssd1306_static_buffer_used = true;
+  ssd->ram_buffer = ssd1306_static_buffer;
+  ssd->shadow = ssd1306_static_shadow;
+#else
+  ssd->ram_buffer = calloc(ssd->bufsize, sizeof(uint8_t));
+  ssd->shadow = calloc(ssd->bufsize - 1, sizeof(uint8_t));
+#endif
+  ssd->ram_buffer[0] = 0x40;
+  ssd->port_buffer[0] = 0x80;
+  ssd->send_hook = NULL;
+  ssd->shadow_valid = false;
+  ssd->pages_sent = 0;
+  ssd->pages_skipped = 0;
+  ssd->bytes_sent = 0;
+}
+
+// Sequência de inicialização inteira numa só transação I2C
+void ssd1306_config(ssd1306_t *ssd) {
+  const uint8_t init[] = {
+    SET_DISP | 0x00,
+    SET_MEM_ADDR, 0x00,
+    SET_DISP_START_LINE | 0x00,
+    SET_SEG_REMAP | 0x01,
+    SET_MUX_RATIO, SSD1306_ROWS(ssd) - 1,
+    SET_COM_OUT_DIR | 0x08,
+    SET_DISP_OFFSET, 0x00,
+    // 64 linhas: COMs alternados; 32 linhas (e menos): sequenciais
+    SET_COM_PIN_CFG, SSD1306_ROWS(ssd) > 32 ? 0x12 : 0x02,
+    SET_DISP_CLK_DIV, 0x80,
+    SET_PRECHARGE, 0xF1,
+    SET_VCOM_DESEL, 0x30,
+    SET_CONTRAST, 0xFF,
+    SET_ENTIRE_ON,
+    SET_NORM_INV,
+    SET_CHARGE_PUMP, 0x14,
+    SET_DISP | 0x01,
+  };
+  ssd1306_command_list(ssd, init, sizeof(init));
+  ssd1306_invalidate(ssd);
+}
+
+void ssd1306_command(ssd1306_t *ssd, uint8_t command) {
+  ssd->port_buffer[1] = command;
+  i2c_write_blocking(
+    ssd->i2c_port,
+    ssd->address,
+    ssd->port_buffer,
+    2,
+    false
+  );
+}
+
+// Vários comandos na mesma transação: o byte de controle 0x00 (Co = 0,
+// D/C# = 0) indica que todos os bytes seguintes são comandos.
+void ssd1306_command_list(ssd1306_t *ssd, const uint8_t *commands, size_t count) {
+  uint8_t buffer[SSD1306_MAX_COMMANDS + 1];
+  if (count > SSD1306_MAX_COMMANDS)
+    count = SSD1306_MAX_COMMANDS;
+  buffer[0] = 0x00;
+  memcpy(&buffer[1], commands, count);
+  i2c_write_blocking(ssd->i2c_port, ssd->address, buffer, count + 1, false);
+}
+
+// Hash FNV-1a de 32 bits, para comparar telas inteiras
+static uint32_t ssd1306_hash(const uint8_t *data, size_t len) {
+  uint32_t hash = 2166136261u;
+  for (size_t i = 0; i < len; ++i) {
+    hash ^= data[i];
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+// Envia as colunas first_col..last_col das páginas first..last numa única
+// transação (a janela precisa ser retangular: várias páginas só com a largura
+// inteira). O byte de controle 0x40 precisa vir logo antes dos dados, então o
+// byte anterior do framebuffer é trocado temporariamente (para a página 0,
+// coluna 0, ele já é o ram_buffer[0]).
+static void ssd1306_send_window(ssd1306_t *ssd, uint8_t first, uint8_t last, uint8_t first_col, uint8_t last_col) {
+  const uint8_t window[] = {
+    SET_COL_ADDR, first_col, last_col,
+    SET_PAGE_ADDR, first, last,
+  };
+  ssd1306_command_list(ssd, window, sizeof(window));
+
+  size_t offset = first * SSD1306_COLS(ssd) + first_col;
+  size_t len = (last - first) * SSD1306_COLS(ssd) + (last_col - first_col + 1);
+  uint8_t *start = &ssd->ram_buffer[offset];
+  uint8_t saved = *start;
+  *start = 0x40;
+  i2c_write_blocking(ssd->i2c_port, ssd->address, start, len + 1, false);
+  *start = saved;
+  memcpy(&ssd->shadow[offset], &ssd->ram_buffer[offset + 1], len);
+  ssd->bytes_sent += len;
+}
+
+// Envia só o que mudou desde o último envio, comparando com a cópia do que o
+// painel já tem: em cada página, do primeiro ao último byte diferente. Com a
+// tela animada a cada quadro (cabeça e cauda andando pixel a pixel) isso é
+// uma ou duas dezenas de colunas em vez da página inteira.
+void ssd1306_send_data(ssd1306_t *ssd) {
+  if (!ssd->shadow_valid) {
+    ssd1306_send_window(ssd, 0, SSD1306_NPAGES(ssd) - 1, 0, SSD1306_COLS(ssd) - 1);
+    ssd->pages_sent += SSD1306_NPAGES(ssd);
+    ssd->shadow_valid = true;
+  } else {
+    for (uint8_t page = 0; page < SSD1306_NPAGES(ssd); ++page) {
+      const uint8_t *now = &ssd->ram_buffer[1 + page * SSD1306_COLS(ssd)];
+      const uint8_t *sent = &ssd->shadow[page * SSD1306_COLS(ssd)];
+      int first = 0, last = SSD1306_COLS(ssd) - 1;
+      while (first <= last && now[first] == sent[first])
+        first++;
+      if (first > last) {
+        ssd->pages_skipped++;
+        continue;
+      }
+      while (now[last] == sent[last])
+        last--;
+      ssd1306_send_window(ssd, page, page, first, last);
+      ssd->pages_sent++;
+    }
+  }
+
+  if (ssd->send_hook)
+    ssd->send_hook(ssd);
+}
+
+// Força o próximo ssd1306_send_data a enviar a tela inteira
+// (ex.: depois de reiniciar o painel).
+void ssd1306_invalidate(ssd1306_t *ssd) {
+  ssd->shadow_valid = false;
+}
+
+// Hash do framebuffer inteiro (sem o byte de controle), para comparar telas
+// com imagens de referência em testes.
+uint32_t ssd1306_frame_hash(const ssd1306_t *ssd) {
+  return ssd1306_hash(&ssd->ram_buffer[1], ssd->bufsize - 1);
+}
+
+#if SSD1306_RUNTIME_GEOMETRY
+void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value) {
+  if (x >= ssd->width || y >= ssd->height)
+      return; // Evita acesso fora dos limites
+
+  // Calcula o índice corretamente: 
+  // - A primeira posição do buffer é o byte de controle, por isso soma 1.
+  // - Cada página (8 linhas) tem 'width' bytes.
+  uint16_t index = 1 + x + (y / 8) * ssd->width;
+  uint8_t bit = 1 << (y % 8);
+  if (value)
+      ssd->ram_buffer[index] |= bit;
+  else
+      ssd->ram_buffer[index] &= ~bit;
+}
+
+#endif
+
+void ssd1306_fill(ssd1306_t *ssd, bool value) {
+  memset(&ssd->ram_buffer[1], value ? 0xFF : 0x00, SSD1306_COLS(ssd) * SSD1306_NPAGES(ssd));
+}
+
+// Escreve os pixels de 'mask' (8 pixels verticais, LSB em cima) a partir de
+// (x, y), substituindo o que havia. Alinhado a uma página é um único byte;
+// senão, dois.
+static inline void ssd1306_column8(ssd1306_t *ssd, uint8_t x, uint8_t y, uint8_t bits, uint8_t mask) {
+  if (x >= SSD1306_COLS(ssd))
+    return;
+  uint8_t page = y / 8;
+  uint8_t shift = y % 8;
+  uint8_t *column = &ssd->ram_buffer[1 + x];
+  bits &= mask;
+  if (page < SSD1306_NPAGES(ssd)) {
+    uint8_t *byte = &column[page * SSD1306_COLS(ssd)];
+    *byte = (*byte & ~(mask << shift)) | (bits << shift);
+  }
+  if (shift && page + 1 < SSD1306_NPAGES(ssd)) {
+    uint8_t *byte = &column[(page + 1) * SSD1306_COLS(ssd)];
+    *byte = (*byte & ~(mask >> (8 - shift))) | (bits >> (8 - shift));
+  }
+}
+
+void ssd1306_rect(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value, bool fill) {
+  for (uint8_t x = left; x < left + width; ++x) {
+    ssd1306_pixel(ssd, x, top, value);
+    ssd1306_pixel(ssd, x, top + height - 1, value);
+  }
+  for (uint8_t y = top; y < top + height; ++y) {
+    ssd1306_pixel(ssd, left, y, value);
+    ssd1306_pixel(ssd, left + width - 1, y, value);
+  }
+
+  if (fill) {
+    for (uint8_t x = left + 1; x < left + width - 1; ++x) {
+      for (uint8_t y = top + 1; y < top + height - 1; ++y) {
+        ssd1306_pixel(ssd, x, y, value);
+      }
+    }
+  }
+}
+
+void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, bool value) {
+    int dx = abs(x1 - x0);
+    int dy = abs(y1 - y0);
+
+    int sx = (x0 < x1) ? 1 : -1;
+    int sy = (y0 < y1) ? 1 : -1;
+
+    int err = dx - dy;
+
+    while (true) {
+        ssd1306_pixel(ssd, x0, y0, value); // Desenha o pixel atual
+
+        if (x0 == x1 && y0 == y1) break; // Termina quando alcança o ponto final
+
+        int e2 = err * 2;
+
+        if (e2 > -dy) {
+            err -= dy;
+            x0 += sx;
+        }
+
+        if (e2 < dx) {
+            err += dx;
+            y0 += sy;
+        }
+    }
+}
+
+
+void ssd1306_hline(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t y, bool value) {
+  for (uint8_t x = x0; x <= x1; ++x)
+    ssd1306_pixel(ssd, x, y, value);
+}
+
+void ssd1306_vline(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value) {
+  for (uint8_t y = y0; y <= y1; ++y)
+    ssd1306_pixel(ssd, x, y, value);
+}
+
+// Função para desenhar um caractere na tela OLED (8x8, column-major)
+// Cada glifo tem um byte por coluna (LSB = pixel superior, MSB = pixel inferior).
+// A tabela é gerada de assets/fonts só com os caracteres que o jogo usa; os
+// demais saem como espaço.
+void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y)
+{
+    const uint8_t *glyph = font_glyph(c);
+
+    // Desenha o caractere (8 colunas x 8 linhas)
+    for (uint8_t i = 0; i < 8; ++i)
+        ssd1306_column8(ssd, x + i, y, glyph[i], 0xFF);
+}
+
+
+// Função para desenhar uma string
+void ssd1306_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y)
+{
+  while (*str)
+  {
+    ssd1306_draw_char(ssd, *str++, x, y);
+    x += 8;
+    if (x + 8 >= SSD1306_COLS(ssd))
+    {
+      x = 0;
+      y += 8;
+    }
+    if (y + 8 > SSD1306_ROWS(ssd))
+    {
+      break;
+    }
+  }
+}
+
+// NOVA FUNÇÃO: Desenha uma bitmap 8x8 na tela OLED
+// 'bitmap' deve apontar para 8 bytes, cada um representando uma coluna (column-major).
+// Acima da borda superior, as linhas de fora saem da máscara.
+void ssd1306_draw_bitmap(ssd1306_t *ssd, int16_t x, int16_t y, const uint8_t *bitmap) {
+  if (x <= -8 || x >= SSD1306_COLS(ssd) || y <= -8 || y >= SSD1306_ROWS(ssd))
+    return;
+  uint8_t skip = y < 0 ? -y : 0;
+  for (uint8_t i = 0; i < 8; i++) {
+    if (x + i >= 0)
+      ssd1306_column8(ssd, x + i, y + skip, bitmap[i] >> skip, 0xFF >> skip);
+  }
+}
+
+void draw_border(ssd1306_t *ssd, uint8_t style) {
+  if (style == 0) {
+      // Borda sólida: desenha um retângulo completo ao redor do display
+      ssd1306_rect(ssd, 0, 0, SSD1306_COLS(ssd), SSD1306_ROWS(ssd), 1, false);
+  } else if (style == 1) {
+      // Borda pontilhada: desenha pontos espaçados nas bordas
+      for (uint8_t x = 0; x < SSD1306_COLS(ssd); x += 2) {
+          ssd1306_pixel(ssd, x, 0, 1);
+          ssd1306_pixel(ssd, x, SSD1306_ROWS(ssd) - 1, 1);
+      }
+      for (uint8_t y = 0; y < SSD1306_ROWS(ssd); y += 2) {
+          ssd1306_pixel(ssd, 0, y, 1);
+          ssd1306_pixel(ssd, SSD1306_COLS(ssd) - 1, y, 1);
+      }
+  }
+}
\ No newline at end of file
@@ -0,0 +1,40 @@
+#include "world.h"
+#include <string.h>
+
+void world_clear(world_t *world) {
+    memset(world->index, 0, sizeof(world->index));
+    for (int i = 0; i < WORLD_CHUNK_POOL; i++)
+        world->free_list[i] = (uint8_t)(WORLD_CHUNK_POOL - i);  // Pilha: pool[0] sai primeiro
+    world->free_count = WORLD_CHUNK_POOL;
+}
+
+bool world_set(world_t *world, int x, int y, uint8_t value) {
+    uint8_t *slot = &world->index[y >> WORLD_CHUNK_SHIFT][x >> WORLD_CHUNK_SHIFT];
+    if (*slot == 0) {
+        if (value == 0)
+            return true;
+        if (world->free_count == 0)
+            return false;
+        // Bloco novo, todo vazio
+        *slot = world->free_list[--world->free_count];
+        world_chunk_t *fresh = &world->pool[*slot - 1];
+        memset(fresh->cells, 0, sizeof(fresh->cells));
+        fresh->used = 0;
+    }
+
+    world_chunk_t *chunk = &world->pool[*slot - 1];
+    uint8_t *cell = &chunk->cells[((y & (WORLD_CHUNK_SIZE - 1)) << WORLD_CHUNK_SHIFT) |
+                                  (x & (WORLD_CHUNK_SIZE - 1))];
+    if (*cell == 0 && value != 0)
+        chunk->used++;
+    else if (*cell != 0 && value == 0)
+        chunk->used--;
+    *cell = value;
+
+    if (chunk->used == 0) {
+        // Última célula liberada: o bloco volta para o pool
+        world->free_list[world->free_count++] = *slot;
+        *slot = 0;
+    }
+    return true;
+}
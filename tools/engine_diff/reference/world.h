@@ -0,0 +1,72 @@
+#ifndef WORLD_H
+#define WORLD_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Mundo do jogo: grade de ocupação esparsa, dividida em blocos de 8x8 células.
+// Só os blocos com alguma célula ocupada existem, retirados de um pool estático;
+// um bloco volta para o pool quando a última célula dele é liberada. Assim a RAM
+// depende do tamanho das cobras, não do tamanho do mundo (256x256 = 64 KB densos,
+// cerca de 5 KB em blocos).
+
+// Tamanho do mundo em células (CMake: -DSNAKE_WORLD_COLS=256 -DSNAKE_WORLD_ROWS=256).
+// O padrão é o tamanho da tela, como no jogo original.
+#ifndef WORLD_COLS
+#define WORLD_COLS 16
+#endif
+#ifndef WORLD_ROWS
+#define WORLD_ROWS 8
+#endif
+
+#define WORLD_CHUNK_SHIFT 3
+#define WORLD_CHUNK_SIZE (1 << WORLD_CHUNK_SHIFT)   // 8x8 células por bloco
+#define WORLD_CHUNK_COLS (WORLD_COLS / WORLD_CHUNK_SIZE)
+#define WORLD_CHUNK_ROWS (WORLD_ROWS / WORLD_CHUNK_SIZE)
+#define WORLD_CHUNKS (WORLD_CHUNK_COLS * WORLD_CHUNK_ROWS)
+
+// Blocos alocados ao mesmo tempo (no máximo, todos os do mundo)
+#ifndef WORLD_CHUNK_POOL
+#define WORLD_CHUNK_POOL (WORLD_CHUNKS < 64 ? WORLD_CHUNKS : 64)
+#endif
+
+#if (WORLD_COLS % WORLD_CHUNK_SIZE) || (WORLD_ROWS % WORLD_CHUNK_SIZE)
+#error "WORLD_COLS e WORLD_ROWS precisam ser múltiplos de 8"
+#endif
+#if WORLD_COLS > 256 || WORLD_ROWS > 256
+#error "Coordenadas do mundo precisam caber em um byte (telemetria)"
+#endif
+#if WORLD_CHUNK_POOL > 255
+#error "WORLD_CHUNK_POOL precisa caber no índice de blocos (uint8_t)"
+#endif
+
+typedef struct {
+    uint8_t cells[WORLD_CHUNK_SIZE * WORLD_CHUNK_SIZE];
+    uint8_t used;          // Células diferentes de zero
+} world_chunk_t;
+
+typedef struct {
+    uint8_t index[WORLD_CHUNK_ROWS][WORLD_CHUNK_COLS];  // 0 = bloco vazio, n = pool[n - 1]
+    world_chunk_t pool[WORLD_CHUNK_POOL];
+    uint8_t free_list[WORLD_CHUNK_POOL];
+    uint8_t free_count;
+} world_t;
+
+// Esvazia o mundo e devolve todos os blocos ao pool.
+void world_clear(world_t *world);
+
+// Conteúdo da célula (x, y); células de blocos inexistentes valem 0.
+static inline uint8_t world_get(const world_t *world, int x, int y) {
+    uint8_t chunk = world->index[y >> WORLD_CHUNK_SHIFT][x >> WORLD_CHUNK_SHIFT];
+    if (chunk == 0)
+        return 0;
+    return world->pool[chunk - 1].cells[((y & (WORLD_CHUNK_SIZE - 1)) << WORLD_CHUNK_SHIFT) |
+                                        (x & (WORLD_CHUNK_SIZE - 1))];
+}
+
+// Grava a célula, alocando ou liberando o bloco quando preciso. Retorna false
+// (sem gravar) se um valor diferente de zero precisar de um bloco novo e o pool
+// estiver esgotado.
+bool world_set(world_t *world, int x, int y, uint8_t value);
+
+#endif // WORLD_H
@@ -0,0 +1,134 @@
+#!/usr/bin/env python3
+"""Remonta as telas do OLED enviadas pelo streaming do framebuffer (fbstream).
+
+Lê o mesmo fluxo da telemetria (porta serial, arquivo gravado ou stdin),
+aplica os deltas XOR/RLE de cada página e grava um PBM por tela completa:
+
+    python3 tools/fb_decode.py /dev/ttyACM0 -o telas/
+    python3 tools/fb_decode.py captura.bin -o telas/ --scale 4
+
+Quadros delta recebidos antes do primeiro quadro-chave são ignorados.
+"""
+
+import argparse
+import os
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from telemetry_decode import FrameParser, open_source  # noqa: E402
+
+FRAME_FB_PAGE = 0x04
+FRAME_FB_END = 0x05
+PAGE_KEY = 0x80
+
+
+def rle_decode(data, width):
+    """Expande o RLE de uma página para a lista de bytes XOR."""
+    out = []
+    pos = 0
+    while pos < len(data) and len(out) < width:
+        token = data[pos]
+        pos += 1
+        if token < 0x80:
+            out.extend([0] * (token + 1))
+        else:
+            count = token - 0x7F
+            out.extend(data[pos:pos + count])
+            pos += count
+    return out[:width]
+
+
+class FrameAssembler:
+    def __init__(self, width=128, pages=8):
+        self.width = width
+        self.pages = pages
+        self.fb = bytearray(width * pages)
+        self.synced = False
+
+    def page(self, payload):
+        page = payload[2] & 0x7F
+        key = bool(payload[2] & PAGE_KEY)
+        if key and page == 0:
+            self.synced = True
+        if not self.synced:
+            return
+        offset = page * self.width
+        xor = rle_decode(payload[3:], self.width)
+        for i, value in enumerate(xor):
+            base = 0 if key else self.fb[offset + i]
+            self.fb[offset + i] = base ^ value
+
+    def end(self, payload):
+        """Retorna (seq, framebuffer) quando a tela está completa."""
+        seq = payload[0] | (payload[1] << 8)
+        width, pages = payload[2], payload[3]
+        if (width, pages) != (self.width, self.pages):
+            self.width, self.pages = width, pages
+            self.fb = bytearray(width * pages)
+            self.synced = False
+        if not self.synced:
+            return None
+        return seq, bytes(self.fb)
+
+
+def write_pbm(path, fb, width, pages, scale=1):
+    """Converte o layout do SSD1306 (colunas por página, LSB em cima) para PBM P4."""
+    height = pages * 8
+    row_bytes = (width * scale + 7) // 8
+    with open(path, "wb") as f:
+        f.write(b"P4\n%d %d\n" % (width * scale, height * scale))
+        for y in range(height):
+            page, bit = divmod(y, 8)
+            row = bytearray(row_bytes)
+            for x in range(width):
+                if fb[page * width + x] & (1 << bit):
+                    for sx in range(scale):
+                        px = x * scale + sx
+                        row[px // 8] |= 0x80 >> (px % 8)
+            for _ in range(scale):
+                f.write(row)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("source", help="porta serial, arquivo gravado ou '-' para stdin")
+    ap.add_argument("-o", "--out", default="frames", help="diretório de saída")
+    ap.add_argument("--scale", type=int, default=1, help="ampliação das imagens")
+    args = ap.parse_args()
+
+    os.makedirs(args.out, exist_ok=True)
+    read = open_source(args.source)
+    is_stream = not (os.path.isfile(args.source) or args.source == "-")
+    parser = FrameParser()
+    asm = FrameAssembler()
+    count = 0
+    try:
+        while True:
+            data = read(4096)
+            if not data:
+                if is_stream:
+                    continue
+                frames = parser.flush()
+            else:
+                frames = parser.feed(data)
+            parser.text.clear()
+            for frame_type, payload in frames:
+                if frame_type == FRAME_FB_PAGE:
+                    asm.page(payload)
+                elif frame_type == FRAME_FB_END:
+                    done = asm.end(payload)
+                    if done:
+                        seq, fb = done
+                        path = os.path.join(args.out, "frame_%05d.pbm" % count)
+                        write_pbm(path, fb, asm.width, asm.pages, args.scale)
+                        print("%s (seq %d)" % (path, seq))
+                        count += 1
+            if not data:
+                break
+    except KeyboardInterrupt:
+        pass
+    print("%d telas gravadas em %s" % (count, args.out))
+
+
+if __name__ == "__main__":
+    main()
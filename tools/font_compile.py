@@ -0,0 +1,219 @@
+#!/usr/bin/env python3
+"""Compila uma fonte BDF (assets/fonts) para uma tabela const na flash.
+
+Gera font.c/font.h no diretório de saída, só com os glifos usados:
+
+    python3 tools/font_compile.py -o build/generated assets/fonts/snake8x8.bdf \\
+        --scan include/ui.c include/Snake.c --levels assets/levels/*.lvl --keep A-Za-z0-9
+
+Glifos mantidos:
+    --scan     textos das chamadas ssd1306_draw_string/draw_char e dos formatos
+               de snprintf/sprintf nos fontes C (as conversões '%d', '%s'...
+               são ignoradas; os dígitos entram sempre)
+    --levels   nomes dos níveis (mostrados na troca de nível)
+    --keep     caracteres de texto dinâmico, como os nomes dos recordes
+               digitados pela serial; aceita faixas (A-Z)
+
+Os demais caracteres saem como espaço. Cada glifo ocupa uma célula de 8x8 e
+sai no formato das páginas do SSD1306: um byte por coluna, bit 0 em cima.
+"""
+
+import argparse
+import os
+import re
+import sys
+
+SIZE = 8
+FIRST, LAST = 32, 126
+DIGITS = "0123456789"
+DRAW_CALL = re.compile(r"\b(ssd1306_draw_string|ssd1306_draw_char|snprintf|sprintf)\s*\(")
+STRING = re.compile(r'"((?:[^"\\\n]|\\.)*)"')
+CHAR = re.compile(r"'((?:[^'\\\n]|\\.))'")
+CONVERSION = re.compile(r"%[-+ #0]*\d*(?:\.\d+)?(?:hh|h|ll|l|z)?[diouxXcsp%]")
+
+
+class FontError(Exception):
+    pass
+
+
+def parse_bdf(text):
+    """Retorna {código: linhas de pixels 8x8 (linha 0 em cima)}."""
+    ascent = None
+    glyphs = {}
+    lines = iter(text.splitlines())
+    for line in lines:
+        words = line.split()
+        if not words:
+            continue
+        if words[0] == "FONT_ASCENT":
+            ascent = int(words[1])
+        elif words[0] == "STARTCHAR":
+            code, bbx, rows = None, None, []
+            for line in lines:
+                words = line.split()
+                if words and words[0] == "ENCODING":
+                    code = int(words[1])
+                elif words and words[0] == "BBX":
+                    bbx = [int(w) for w in words[1:5]]
+                elif words and words[0] == "BITMAP":
+                    for line in lines:
+                        if line.strip() == "ENDCHAR":
+                            break
+                        rows.append(int(line.strip(), 16))
+                    break
+            if code is None or bbx is None:
+                raise FontError("glifo sem ENCODING ou BBX")
+            if FIRST <= code <= LAST:
+                glyphs[code] = place_glyph(code, bbx, rows, ascent)
+    if ascent is None:
+        raise FontError("FONT_ASCENT ausente")
+    return glyphs
+
+
+def place_glyph(code, bbx, rows, ascent):
+    """Posiciona o bitmap do glifo (BBX relativo à linha de base) na célula 8x8."""
+    width, height, xoff, yoff = bbx
+    top = ascent - (yoff + height)
+    if xoff < 0 or top < 0 or xoff + width > SIZE or top + height > SIZE or len(rows) != height:
+        raise FontError("glifo %d (%r) não cabe numa célula de %dx%d" % (code, chr(code), SIZE, SIZE))
+    row_bits = ((width + 7) // 8) * 8
+    pixels = [[False] * SIZE for _ in range(SIZE)]
+    for r, bits in enumerate(rows):
+        for c in range(width):
+            if bits >> (row_bits - 1 - c) & 1:
+                pixels[top + r][xoff + c] = True
+    return pixels
+
+
+def unescape(literal):
+    return bytes(literal, "utf-8").decode("unicode_escape", errors="replace")
+
+
+def scan_source(text):
+    """Caracteres dos textos desenhados: literais dentro das chamadas de desenho
+    e formatação (até o ';' que fecha o comando)."""
+    text = re.sub(r"//[^\n]*|/\*.*?\*/", "", text, flags=re.S)
+    chars = set()
+    for call in DRAW_CALL.finditer(text):
+        end = text.find(";", call.end())
+        statement = text[call.end():end if end >= 0 else len(text)]
+        for literal in STRING.findall(statement):
+            chars |= set(CONVERSION.sub("", unescape(literal)))
+        if call.group(1) == "ssd1306_draw_char":
+            chars |= set(unescape(c) for c in CHAR.findall(statement))
+    return chars
+
+
+def level_names(text):
+    for line in text.splitlines():
+        key, _, value = line.partition(":")
+        if key.strip() == "name":
+            yield value.strip()
+
+
+def expand_ranges(spec):
+    chars, i = set(), 0
+    while i < len(spec):
+        if i + 2 < len(spec) and spec[i + 1] == "-":
+            chars |= set(chr(c) for c in range(ord(spec[i]), ord(spec[i + 2]) + 1))
+            i += 3
+        else:
+            chars.add(spec[i])
+            i += 1
+    return chars
+
+
+def page_bytes(pixels):
+    return [sum(1 << y for y in range(SIZE) if pixels[y][x]) for x in range(SIZE)]
+
+
+def c_char(ch):
+    # Uma '\' no fim de um comentário // continuaria na linha seguinte
+    return {" ": "espaço", "\\": "barra invertida"}.get(ch, repr(ch))
+
+
+def write_outputs(out_dir, font_name, kept, glyphs):
+    os.makedirs(out_dir, exist_ok=True)
+    banner = "// Gerado por tools/font_compile.py a partir de assets/fonts -- não editar"
+    header = [banner, "#ifndef FONT_H", "#define FONT_H", "", "#include <stdint.h>", "",
+              "#define FONT_FIRST %d" % FIRST,
+              "#define FONT_LAST %d" % LAST,
+              "#define FONT_GLYPHS %d" % len(kept), "",
+              "// Glifos usados pelo jogo (8 bytes, um por coluna, bit 0 em cima); o 0 é o espaço",
+              "extern const uint8_t font_glyphs[FONT_GLYPHS][8];",
+              "// Caractere (FONT_FIRST..FONT_LAST) -> glifo; 0 para os descartados",
+              "extern const uint8_t font_map[FONT_LAST - FONT_FIRST + 1];", "",
+              "static inline const uint8_t *font_glyph(char c) {",
+              "    uint8_t ch = (uint8_t)c;",
+              "    return font_glyphs[ch >= FONT_FIRST && ch <= FONT_LAST ? font_map[ch - FONT_FIRST] : 0];",
+              "}", "", "#endif // FONT_H", ""]
+
+    index = {ch: i for i, ch in enumerate(kept)}
+    source = [banner, '#include "font.h"', "",
+              "// %s: %d de %d glifos; const, lidos pela XIP" % (font_name, len(kept), LAST - FIRST + 1),
+              "const uint8_t font_glyphs[FONT_GLYPHS][8] = {"]
+    for ch in kept:
+        source.append("    {%s},  // %s" % (", ".join("0x%02X" % b for b in page_bytes(glyphs[ord(ch)])),
+                                            c_char(ch)))
+    source += ["};", "", "const uint8_t font_map[FONT_LAST - FONT_FIRST + 1] = {"]
+    for start in range(FIRST, LAST + 1, 16):
+        row = [index.get(chr(c), 0) for c in range(start, min(start + 16, LAST + 1))]
+        source.append("    %s," % ", ".join("%2d" % v for v in row))
+    source += ["};", ""]
+
+    for fname, lines in (("font.h", header), ("font.c", source)):
+        path = os.path.join(out_dir, fname)
+        content = "\n".join(lines)
+        # Não reescreve arquivos iguais, para não recompilar à toa
+        if os.path.exists(path) and open(path).read() == content:
+            continue
+        with open(path, "w") as f:
+            f.write(content)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("font", help="fonte .bdf")
+    ap.add_argument("-o", "--out", required=True, help="diretório de saída")
+    ap.add_argument("--scan", nargs="*", default=[], help="fontes C com textos desenhados")
+    ap.add_argument("--levels", nargs="*", default=[], help="níveis (.lvl), pelos nomes")
+    ap.add_argument("--keep", default="", help="caracteres mantidos sempre (aceita faixas, ex.: A-Z)")
+    args = ap.parse_args()
+
+    with open(args.font) as f:
+        try:
+            glyphs = parse_bdf(f.read())
+        except (FontError, ValueError, IndexError) as e:
+            print("%s: %s" % (args.font, e), file=sys.stderr)
+            return 1
+
+    used = set(" " + DIGITS) | expand_ranges(args.keep)
+    for path in args.scan:
+        with open(path, encoding="utf-8") as f:
+            used |= scan_source(f.read())
+    for path in args.levels:
+        with open(path, encoding="utf-8") as f:
+            for name in level_names(f.read()):
+                used |= set(name)
+
+    missing = sorted(ch for ch in used if FIRST <= ord(ch) <= LAST and ord(ch) not in glyphs)
+    if missing:
+        print("%s: sem glifo para %s" % (args.font, " ".join(repr(ch) for ch in missing)), file=sys.stderr)
+        return 1
+    ignored = sorted(ch for ch in used if not FIRST <= ord(ch) <= LAST)
+    if ignored:
+        print("aviso: fora do ASCII imprimível (sai como espaço): %s"
+              % " ".join(repr(ch) for ch in ignored), file=sys.stderr)
+    # Espaço primeiro: é o glifo 0, usado pelos caracteres descartados
+    kept = [" "] + sorted(ch for ch in used if FIRST < ord(ch) <= LAST)
+
+    font_name = os.path.splitext(os.path.basename(args.font))[0]
+    write_outputs(args.out, font_name, kept, glyphs)
+    size = len(kept) * SIZE + (LAST - FIRST + 1)
+    print("fonte %s: %d de %d glifos, %d bytes na flash (tabela inteira: %d)"
+          % (font_name, len(kept), len(glyphs), size, len(glyphs) * SIZE))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
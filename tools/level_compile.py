@@ -0,0 +1,168 @@
+#!/usr/bin/env python3
+"""Compila os níveis (assets/levels/*.lvl) para blobs const na flash.
+
+Gera levels.c/levels.h no diretório de saída, com um level_t (include/level.h)
+por arquivo, na ordem alfabética dos nomes:
+
+    python3 tools/level_compile.py --cols 16 --rows 8 -o build/generated assets/levels/*.lvl
+
+Formato de um .lvl (linhas com '#' no início, antes do mapa, são comentários):
+
+    name: caixa
+    spawn: 8,2,right        # cabeça do jogador 1 (x, y, direção)
+    spawn2: 7,5,left        # jogador 2 no versus (opcional: espelho do 1)
+    wrap: no                # bordas teletransportam (yes) ou são paredes (no)
+    target: 10              # comidas para passar de nível (0 = sem fim)
+    map:
+    ################
+    #..............#
+
+No mapa, '#' é obstáculo e '.' ou espaço é livre. Um mapa menor que o mundo é
+completado com células livres à direita e embaixo.
+"""
+
+import argparse
+import os
+import sys
+
+DIRECTIONS = {"right": 0, "down": 1, "left": 2, "up": 3}
+STEPS = {0: (1, 0), 1: (0, 1), 2: (-1, 0), 3: (0, -1)}
+NAME_MAX = 12
+FLAG_WRAP = 0x01
+SNAKE_START_LENGTH = 3
+
+
+class LevelError(Exception):
+    pass
+
+
+def parse_spawn(text):
+    parts = [p.strip() for p in text.split(",")]
+    if len(parts) != 3 or parts[2] not in DIRECTIONS:
+        raise LevelError("spawn inválido: %r" % text)
+    return int(parts[0]), int(parts[1]), DIRECTIONS[parts[2]]
+
+
+def parse_level(text, cols, rows):
+    fields = {}
+    lines = text.splitlines()
+    for n, line in enumerate(lines):
+        if line.strip() == "map:":
+            art = lines[n + 1:]
+            break
+        if not line.strip() or line.lstrip().startswith("#"):
+            continue
+        key, sep, value = line.partition(":")
+        if not sep:
+            raise LevelError("linha inválida: %r" % line)
+        fields[key.strip()] = value.split("#")[0].strip()
+    else:
+        raise LevelError("faltou 'map:'")
+
+    while art and not art[-1].strip():
+        art.pop()
+    if len(art) > rows or any(len(l.rstrip()) > cols for l in art):
+        raise LevelError("mapa maior que o mundo (%dx%d)" % (cols, rows))
+    walls = [[False] * cols for _ in range(rows)]
+    for y, line in enumerate(art):
+        for x, ch in enumerate(line.rstrip()):
+            if ch == "#":
+                walls[y][x] = True
+            elif ch not in ". ":
+                raise LevelError("caractere inválido no mapa: %r" % ch)
+
+    wrap = fields.get("wrap", "yes")
+    if wrap not in ("yes", "no"):
+        raise LevelError("wrap deve ser yes ou no")
+    spawn1 = parse_spawn(fields.get("spawn", "%d,%d,right" % (cols // 2, rows // 2)))
+    if "spawn2" in fields:
+        spawn2 = parse_spawn(fields["spawn2"])
+    else:
+        spawn2 = (cols - 1 - spawn1[0], rows - 1 - spawn1[1], (spawn1[2] + 2) % 4)
+
+    # O corpo inicial (cabeça e dois segmentos atrás) precisa caber em células livres
+    for x, y, d in (spawn1, spawn2):
+        dx, dy = STEPS[d]
+        for i in range(SNAKE_START_LENGTH):
+            cx, cy = x - dx * i, y - dy * i
+            if wrap == "yes":
+                cx, cy = cx % cols, cy % rows
+            if not (0 <= cx < cols and 0 <= cy < rows) or walls[cy][cx]:
+                raise LevelError("cobra nasce fora do mundo ou numa parede: %d,%d" % (x, y))
+
+    name = fields.get("name", "")
+    if len(name) >= NAME_MAX:
+        raise LevelError("nome com mais de %d caracteres" % (NAME_MAX - 1))
+    target = int(fields.get("target", "0"))
+    if not 0 <= target <= 255:
+        raise LevelError("target fora de 0..255")
+
+    bitmap = []
+    for row in walls:
+        for x in range(0, cols, 8):
+            byte = 0
+            for bit in range(8):
+                if row[x + bit]:
+                    byte |= 0x80 >> bit
+            bitmap.append(byte)
+    return {"name": name, "spawn": (spawn1, spawn2), "wrap": wrap == "yes",
+            "target": target, "bitmap": bitmap}
+
+
+def write_outputs(out_dir, levels, cols):
+    os.makedirs(out_dir, exist_ok=True)
+    banner = "// Gerado por tools/level_compile.py a partir de assets/levels -- não editar"
+    header = [banner, "#ifndef LEVELS_H", "#define LEVELS_H", "", '#include "level.h"', "",
+              "#define LEVEL_COUNT %d" % len(levels), "",
+              "extern const level_t levels[LEVEL_COUNT];", "", "#endif // LEVELS_H", ""]
+    source = [banner, '#include "levels.h"', "",
+              "// const: fica na flash e é lido pela XIP", "const level_t levels[LEVEL_COUNT] = {"]
+    row_bytes = cols // 8
+    for src, lvl in levels:
+        source.append("    // %s" % src)
+        source.append("    {")
+        source.append('        .name = "%s",' % lvl["name"])
+        source.append("        .spawn = {%s}," % ", ".join("{%d, %d, %d}" % s for s in lvl["spawn"]))
+        source.append("        .flags = %s," % ("LEVEL_FLAG_WRAP" if lvl["wrap"] else "0"))
+        source.append("        .target = %d," % lvl["target"])
+        source.append("        .walls = {")
+        bitmap = lvl["bitmap"]
+        for i in range(0, len(bitmap), row_bytes):
+            source.append("            {" + ", ".join("0x%02X" % b for b in bitmap[i:i + row_bytes]) + "},")
+        source.append("        },")
+        source.append("    },")
+    source += ["};", ""]
+    for fname, lines in (("levels.h", header), ("levels.c", source)):
+        path = os.path.join(out_dir, fname)
+        content = "\n".join(lines)
+        # Não reescreve arquivos iguais, para não recompilar à toa
+        if os.path.exists(path) and open(path).read() == content:
+            continue
+        with open(path, "w") as f:
+            f.write(content)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("sources", nargs="+", help="arquivos .lvl")
+    ap.add_argument("--cols", type=int, required=True, help="largura do mundo (WORLD_COLS)")
+    ap.add_argument("--rows", type=int, required=True, help="altura do mundo (WORLD_ROWS)")
+    ap.add_argument("-o", "--out", required=True, help="diretório de saída")
+    args = ap.parse_args()
+
+    levels = []
+    for path in sorted(args.sources):
+        with open(path) as f:
+            try:
+                levels.append((os.path.basename(path), parse_level(f.read(), args.cols, args.rows)))
+            except (LevelError, ValueError) as e:
+                print("%s: %s" % (path, e), file=sys.stderr)
+                return 1
+    write_outputs(args.out, levels, args.cols)
+    size = len(levels) * (NAME_MAX + 6 + 2 + args.rows * args.cols // 8)
+    print("%d níveis, %d bytes na flash" % (len(levels), size))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
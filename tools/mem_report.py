@@ -0,0 +1,200 @@
+#!/usr/bin/env python3
+"""Relatório de uso de memória por módulo a partir do map do linker.
+
+Soma, por arquivo objeto, o que vai para a flash (.text, .rodata e a imagem
+de .data) e para a RAM (.data, .bss, código copiado para a RAM), e junta a
+maior pilha por função dos arquivos .su gerados com -fstack-usage.
+
+    python3 tools/mem_report.py build/SnakeGame.elf.map --su-dir build/CMakeFiles/SnakeGame.dir
+    python3 tools/mem_report.py SnakeGame.elf.map --ram-budget 65536 --flash-budget 262144
+
+Com orçamentos definidos, sai com erro se algum total passar do limite.
+"""
+
+import argparse
+import os
+import re
+import sys
+from collections import defaultdict
+
+# Seções de entrada -> (conta na flash, conta na RAM)
+FLASH_ONLY = (".text", ".rodata", ".boot2", ".binary_info", ".ARM.exidx", ".ARM.extab",
+              ".init", ".fini", ".vectors", ".flashdata", ".embedded_block")
+FLASH_AND_RAM = (".data", ".time_critical", ".ram_vector_table")
+RAM_ONLY = (".bss", "COMMON", ".uninitialized_data", ".heap", ".stack", ".scratch_x", ".scratch_y")
+
+INPUT_SECTION = re.compile(r"^ ((?:\.|COMMON)\S*)(?:\s+(0x[0-9a-fA-F]+)\s+(0x[0-9a-fA-F]+)\s+(.+))?$")
+CONTINUATION = re.compile(r"^\s+(0x[0-9a-fA-F]+)\s+(0x[0-9a-fA-F]+)\s+(.+)$")
+
+
+def classify(section):
+    for prefix in FLASH_AND_RAM:
+        if section.startswith(prefix):
+            return True, True
+    for prefix in RAM_ONLY:
+        if section.startswith(prefix):
+            return False, True
+    for prefix in FLASH_ONLY:
+        if section.startswith(prefix):
+            return True, False
+    return None
+
+
+def strip_object_ext(base):
+    for ext in (".obj", ".o", ".su"):
+        if base.endswith(ext):
+            return base[: -len(ext)]
+    return base
+
+
+def module_name(path):
+    """Objeto do projeto -> nome do fonte; SDK e bibliotecas -> 'sdk:<nome>'.
+
+    O Pico SDK compila suas fontes dentro de CMakeFiles/<alvo>.dir/ espelhando o
+    caminho absoluto; as do projeto ficam a no máximo um diretório de distância.
+    """
+    path = path.strip()
+    m = re.match(r"(.*/)?(lib[^/()]+)\.a\(([^)]+)\)$", path)
+    if m:
+        return "sdk:" + m.group(2)
+    base = strip_object_ext(os.path.basename(path))
+    m = re.search(r"CMakeFiles/[^/]+\.dir/(.*)$", path)
+    if m and m.group(1).count("/") > 1:
+        return "sdk:" + base
+    if not m and os.path.isabs(path):
+        return "sdk:" + base
+    return base
+
+
+def parse_map(path):
+    flash = defaultdict(int)
+    ram = defaultdict(int)
+    heap_users = []
+    in_memory_map = False
+    in_archive = False
+    pending = None
+    last_archive_member = None
+    with open(path, errors="replace") as f:
+        for line in f:
+            line = line.rstrip("\n")
+            if line.startswith("Archive member included"):
+                in_archive = True
+                continue
+            if line.startswith("Linker script and memory map"):
+                in_memory_map = True
+                in_archive = False
+                continue
+            if in_archive:
+                if line.startswith("Discarded input sections") or line.startswith("Memory Configuration"):
+                    in_archive = False
+                    continue
+                if line and not line[0].isspace():
+                    last_archive_member = line
+                elif last_archive_member and "(" in line:
+                    # "                              objeto (símbolo)"
+                    m = re.search(r"\((\w+)\)\s*$", line)
+                    if m and m.group(1) in ("malloc", "calloc", "realloc", "_malloc_r", "__wrap_malloc", "__wrap_calloc"):
+                        heap_users.append((m.group(1), line.strip().rsplit(" ", 1)[0]))
+                continue
+            if not in_memory_map:
+                continue
+
+            if pending is not None:
+                m = CONTINUATION.match(line)
+                section = pending
+                pending = None
+                if m:
+                    add(section, int(m.group(2), 16), m.group(3), flash, ram)
+                continue
+            m = INPUT_SECTION.match(line)
+            if not m:
+                continue
+            section = m.group(1)
+            if m.group(2) is None:
+                pending = section
+                continue
+            add(section, int(m.group(3), 16), m.group(4), flash, ram)
+    return flash, ram, heap_users
+
+
+def add(section, size, path, flash, ram):
+    kind = classify(section)
+    if kind is None or size == 0 or "(size before relaxing)" in path:
+        return
+    name = module_name(path)
+    if kind[0]:
+        flash[name] += size
+    if kind[1]:
+        ram[name] += size
+
+
+def parse_stack_usage(su_dir):
+    """Maior pilha por módulo (função mais funda) a partir dos .su."""
+    stacks = {}
+    if not su_dir:
+        return stacks
+    for root, _, files in os.walk(su_dir):
+        for fname in files:
+            if not fname.endswith(".su"):
+                continue
+            rel = os.path.relpath(os.path.join(root, fname), su_dir)
+            module = strip_object_ext(fname)
+            if rel.count(os.sep) > 1:
+                module = "sdk:" + module
+            best = stacks.get(module, (0, "", ""))
+            with open(os.path.join(root, fname)) as f:
+                for line in f:
+                    parts = line.rstrip("\n").split("\t")
+                    if len(parts) < 3:
+                        continue
+                    size = int(parts[1])
+                    if size > best[0]:
+                        func = parts[0].rsplit(":", 1)[-1]
+                        best = (size, func, parts[2])
+            stacks[module] = best
+    return stacks
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("map", help="arquivo .map gerado pelo linker")
+    ap.add_argument("--su-dir", help="diretório com os .su de -fstack-usage")
+    ap.add_argument("--ram-budget", type=int, help="limite de RAM estática em bytes")
+    ap.add_argument("--flash-budget", type=int, help="limite de flash em bytes")
+    args = ap.parse_args()
+
+    flash, ram, heap_users = parse_map(args.map)
+    stacks = parse_stack_usage(args.su_dir)
+
+    project = sorted(m for m in set(flash) | set(ram) if not m.startswith("sdk:"))
+    sdk = sorted(m for m in set(flash) | set(ram) if m.startswith("sdk:"))
+
+    print("%-28s %9s %9s %7s  %s" % ("modulo", "flash", "ram", "pilha", "funcao mais funda"))
+    for name in project + sdk:
+        stack = stacks.get(name)
+        stack_txt = "%7d  %s (%s)" % stack if stack else "%7s" % "-"
+        print("%-28s %9d %9d %s" % (name, flash[name], ram[name], stack_txt))
+
+    total_flash = sum(flash.values())
+    total_ram = sum(ram.values())
+    print("%-28s %9d %9d" % ("TOTAL", total_flash, total_ram))
+    print("%-28s %9d %9d" % ("  projeto", sum(flash[m] for m in project), sum(ram[m] for m in project)))
+
+    if heap_users:
+        for sym, obj in heap_users:
+            print("heap: %s puxado por %s" % (sym, obj))
+    else:
+        print("heap: nenhum malloc/calloc referenciado")
+
+    failed = False
+    if args.ram_budget is not None and total_ram > args.ram_budget:
+        print("ERRO: RAM %d excede o orcamento de %d bytes" % (total_ram, args.ram_budget), file=sys.stderr)
+        failed = True
+    if args.flash_budget is not None and total_flash > args.flash_budget:
+        print("ERRO: flash %d excede o orcamento de %d bytes" % (total_flash, args.flash_budget), file=sys.stderr)
+        failed = True
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
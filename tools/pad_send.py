@@ -0,0 +1,204 @@
+#!/usr/bin/env python3
+"""Envia roteiros de entradas ao SnakeGame pelo controle remoto (include/remote.h).
+
+Cada linha do roteiro é um atraso em ms desde o pacote anterior seguido das
+ações do pacote: uma direção (right, down, left, up) e/ou botões (a = pausa,
+b = som, joy = botão do joystick). '#' começa um comentário.
+
+    0    joy          # sai da tela de placar
+    300  up
+    150  right
+    500  a            # pausa
+
+    python3 tools/pad_send.py /dev/ttyACM0 roteiro.txt
+    python3 tools/pad_send.py --raw roteiro.bin roteiro.txt
+    python3 tools/pad_send.py /dev/ttyACM0 roteiro.bin
+    python3 tools/engine_diff.py --replay roteiro.bin
+
+Com uma porta serial, a telemetria é lida em paralelo: cada pacote é
+confirmado por um evento 'remote' com o resultado e a latência medida na
+placa (da chegada até o tick que aplicou a curva), e o script soma o tempo
+de ida e volta visto do host. O seq do pacote tem 8 bits, então só os
+últimos 128 pacotes aguardam confirmação; as que chegam depois disso são
+ignoradas em vez de casar com outro pacote.
+
+Com --raw, só grava o roteiro em binário, com os atrasos: "PAD1" seguido de
+um registro por pacote, [atraso em ms u16][pacote de 4 bytes]. O arquivo
+pode ser enviado de novo a uma placa (no lugar do roteiro em texto) ou
+reproduzido no host pelo tools/engine_diff.py --replay, nas duas versões do
+motor. Requer pyserial para a porta serial.
+"""
+
+import argparse
+import os
+import sys
+import time
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from telemetry_decode import FRAME_EVENT, FrameParser, REMOTE_RESULTS, crc8, u16  # noqa: E402
+
+SYNC = 0xC5
+DIR_NONE = 0x0F
+DIRECTIONS = {"right": 0, "down": 1, "left": 2, "up": 3}
+BUTTONS = {"a": 0x10, "b": 0x20, "joy": 0x40}
+EVENT_REMOTE = 7
+ACK_TIMEOUT_S = 1.0
+# O seq tem 8 bits: só os últimos ACK_WINDOW pacotes esperam confirmação, para
+# uma confirmação atrasada nunca casar com o pacote 256 números depois
+ACK_WINDOW = 128
+RAW_MAGIC = b"PAD1"
+RAW_RECORD = 6
+MAX_DELAY_MS = 0xFFFF
+
+
+class ScriptError(Exception):
+    pass
+
+
+def parse_script(text):
+    steps = []
+    for n, line in enumerate(text.splitlines(), 1):
+        words = line.split("#")[0].split()
+        if not words:
+            continue
+        try:
+            delay = int(words[0])
+        except ValueError:
+            raise ScriptError("linha %d: atraso inválido %r" % (n, words[0]))
+        direction, buttons = DIR_NONE, 0
+        for word in words[1:]:
+            if word in DIRECTIONS and direction == DIR_NONE:
+                direction = DIRECTIONS[word]
+            elif word in BUTTONS:
+                buttons |= BUTTONS[word]
+            else:
+                raise ScriptError("linha %d: ação inválida %r" % (n, word))
+        if direction == DIR_NONE and not buttons:
+            raise ScriptError("linha %d: pacote sem ações" % n)
+        steps.append((delay, buttons | direction, " ".join(words[1:])))
+    return steps
+
+
+def describe(control):
+    words = [name for name, code in DIRECTIONS.items() if control & 0x0F == code]
+    words += [name for name, bit in BUTTONS.items() if control & bit]
+    return " ".join(words)
+
+
+def parse_raw(data):
+    if (len(data) - len(RAW_MAGIC)) % RAW_RECORD:
+        raise ScriptError("gravação truncada")
+    steps = []
+    for pos in range(len(RAW_MAGIC), len(data), RAW_RECORD):
+        delay = data[pos] | (data[pos + 1] << 8)
+        pkt = data[pos + 2:pos + 6]
+        if pkt[0] != SYNC or crc8(pkt[1:3]) != pkt[3]:
+            raise ScriptError("pacote inválido no byte %d" % (pos + 2))
+        steps.append((delay, pkt[1], describe(pkt[1])))
+    return steps
+
+
+def load_steps(path):
+    with open(path, "rb") as f:
+        data = f.read()
+    if data.startswith(RAW_MAGIC):
+        return parse_raw(data)
+    return parse_script(data.decode("utf-8"))
+
+
+def write_raw(path, steps):
+    with open(path, "wb") as f:
+        f.write(RAW_MAGIC)
+        for seq, (delay, control, _) in enumerate(steps):
+            if delay > MAX_DELAY_MS:
+                raise ScriptError("atraso de %d ms não cabe na gravação (máximo %d)" % (delay, MAX_DELAY_MS))
+            f.write(bytes([delay & 0xFF, delay >> 8]) + packet(control, seq))
+
+
+def packet(control, seq):
+    body = bytes([control, seq & 0xFF])
+    return bytes([SYNC]) + body + bytes([crc8(body)])
+
+
+def read_acks(read, parser, pending, acks):
+    """Casa as confirmações com os pacotes pendentes (seq & 0xFF -> índice)."""
+    for frame_type, payload in parser.feed(read(4096)):
+        if frame_type == FRAME_EVENT and payload[2] == EVENT_REMOTE:
+            data = payload[3:]
+            index = pending.pop(data[0], None)
+            if index is not None:  # Fora da janela: confirmação velha, ignorada
+                acks[index] = (time.monotonic(), data[1], u16(data, 2) | (u16(data, 4) << 16))
+    parser.text.clear()
+
+
+def expire(pending, oldest):
+    for seq, index in list(pending.items()):
+        if index < oldest:
+            del pending[seq]
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("port", nargs="?", help="porta serial da placa")
+    ap.add_argument("script", help="roteiro de entradas (texto ou gravação PAD1)")
+    ap.add_argument("--raw", help="só grava o roteiro em binário neste arquivo")
+    args = ap.parse_args()
+    if not args.port and not args.raw:
+        ap.error("informe a porta serial ou --raw")
+
+    try:
+        steps = load_steps(args.script)
+    except (ScriptError, UnicodeDecodeError) as e:
+        print("%s: %s" % (args.script, e), file=sys.stderr)
+        return 1
+
+    if args.raw:
+        try:
+            write_raw(args.raw, steps)
+        except ScriptError as e:
+            print("%s: %s" % (args.script, e), file=sys.stderr)
+            return 1
+        print("%d pacotes gravados em %s" % (len(steps), args.raw))
+        return 0
+
+    import serial  # pyserial
+    port = serial.Serial(args.port, 115200, timeout=0.005)
+    parser = FrameParser()
+    pending = {}
+    acks = {}
+    sent = []
+    for seq, (delay, control, label) in enumerate(steps):
+        until = time.monotonic() + delay / 1000.0
+        while time.monotonic() < until:
+            read_acks(port.read, parser, pending, acks)
+        expire(pending, seq - ACK_WINDOW + 1)
+        port.write(packet(control, seq))
+        port.flush()
+        pending[seq & 0xFF] = seq
+        sent.append((seq, time.monotonic(), label))
+
+    deadline = time.monotonic() + ACK_TIMEOUT_S
+    while time.monotonic() < deadline and pending:
+        read_acks(port.read, parser, pending, acks)
+
+    device, round_trip = [], []
+    for seq, t_write, label in sent:
+        if seq not in acks:
+            print("%3d  %-12s  sem confirmação" % (seq, label))
+            continue
+        t_ack, result, latency = acks[seq]
+        rtt_ms = (t_ack - t_write) * 1000.0
+        print("%3d  %-12s  %-8s  placa %6d us  ida e volta %6.1f ms"
+              % (seq, label, REMOTE_RESULTS.get(result, "?"), latency, rtt_ms))
+        if result == 0:
+            device.append(latency)
+            round_trip.append(rtt_ms)
+    if device:
+        print("aplicados %d/%d: placa média %d us (max %d), ida e volta média %.1f ms (max %.1f)"
+              % (len(device), len(sent), sum(device) // len(device), max(device),
+                 sum(round_trip) / len(round_trip), max(round_trip)))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
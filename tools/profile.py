@@ -0,0 +1,225 @@
+#!/usr/bin/env python3
+"""Perfil por amostragem do SnakeGame, simbolizado contra o ELF.
+
+Lê os quadros TLM_FRAME_PROFILE do fluxo da telemetria (porta serial, arquivo
+gravado ou stdin), resolve cada PC amostrado para a função do ELF do alvo
+SnakeGame e imprime um perfil plano; opcionalmente grava pilhas dobradas
+(formato do flamegraph.pl e do speedscope):
+
+    python3 tools/profile.py /dev/ttyACM0 --elf build/SnakeGame.elf --record perfil.bin
+    python3 tools/profile.py perfil.bin --elf build/SnakeGame.elf --folded perfil.folded
+    flamegraph.pl perfil.folded > perfil.svg
+
+Na porta serial, Ctrl+C encerra a captura e imprime o perfil. A amostragem é
+ligada no console ('prof 1000') ou no build (-DSNAKE_PROFILER_HZ=1000).
+
+Cada pilha dobrada é estágio;chamador;função. O chamador vem do LR empilhado
+na interrupção e só é confiável em funções folha (ou antes do prólogo salvar
+o LR): quando ele cai na própria função, a pilha fica só estágio;função.
+"""
+
+import argparse
+import bisect
+import os
+import struct
+import sys
+from collections import Counter
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from telemetry_decode import FRAME_PROFILE, FrameParser, loop_stage, open_source, u16  # noqa: E402
+
+HEADER_BYTES = 6
+SAMPLE_BYTES = 9
+ROM_END = 0x4000           # Rotinas da ROM do RP2040 (memcpy, divisão, ponto flutuante)
+SHT_SYMTAB = 2
+STT_FUNC = 2
+EM_ARM = 40
+
+
+class ElfError(Exception):
+    pass
+
+
+class Symbolizer:
+    """Funções da tabela de símbolos de um ELF (32 ou 64 bits, little-endian)."""
+
+    def __init__(self, data):
+        if data[:4] != b"\x7fELF":
+            raise ElfError("não é um ELF")
+        if data[5] != 1:
+            raise ElfError("só ELF little-endian")
+        is64 = data[4] == 2
+        machine = u16(data, 18)
+        if is64:
+            shoff, = struct.unpack_from("<Q", data, 40)
+            shentsize, shnum = struct.unpack_from("<HH", data, 58)
+        else:
+            shoff, = struct.unpack_from("<I", data, 32)
+            shentsize, shnum = struct.unpack_from("<HH", data, 46)
+
+        sections = []
+        for i in range(shnum):
+            off = shoff + i * shentsize
+            if is64:
+                _, kind, _, _, offset, size, link, _, _, entsize = struct.unpack_from("<IIQQQQIIQQ", data, off)
+            else:
+                _, kind, _, _, offset, size, link, _, _, entsize = struct.unpack_from("<IIIIIIIIII", data, off)
+            sections.append((kind, offset, size, link, entsize))
+
+        funcs = []
+        for kind, offset, size, link, entsize in sections:
+            if kind != SHT_SYMTAB:
+                continue
+            strtab_off = sections[link][1]
+            for pos in range(offset, offset + size, entsize):
+                if is64:
+                    name, info, _, shndx, value, sym_size = struct.unpack_from("<IBBHQQ", data, pos)
+                else:
+                    name, value, sym_size, info, _, shndx = struct.unpack_from("<IIIBBH", data, pos)
+                if info & 0xF != STT_FUNC or shndx == 0:
+                    continue
+                if machine == EM_ARM:
+                    value &= ~1  # Bit de Thumb
+                end = data.index(b"\0", strtab_off + name)
+                funcs.append((value, -sym_size, data[strtab_off + name:end].decode("utf-8", "replace")))
+        if not funcs:
+            raise ElfError("ELF sem tabela de símbolos (compilado com strip?)")
+
+        # Apelidos no mesmo endereço: fica o de maior tamanho
+        funcs.sort()
+        self.starts, self.sizes, self.names = [], [], []
+        for value, neg_size, name in funcs:
+            if self.starts and self.starts[-1] == value:
+                continue
+            self.starts.append(value)
+            self.sizes.append(-neg_size)
+            self.names.append(name)
+
+    def lookup(self, addr):
+        i = bisect.bisect_right(self.starts, addr) - 1
+        if i >= 0:
+            size = self.sizes[i]
+            if addr < self.starts[i] + size or (size == 0 and i + 1 < len(self.starts)):
+                return self.names[i]
+        if addr < ROM_END:
+            return "[rom]"
+        return "[0x%08x]" % addr
+
+
+class Profile:
+    """Acumula as amostras dos quadros e conta as perdidas."""
+
+    def __init__(self):
+        self.samples = []          # (pc, lr, estágio)
+        self.hz = 0
+        self.lost_buffer = 0       # Descartadas no buffer da placa
+        self.lost_link = 0         # Em quadros que não chegaram (saltos de seq)
+        self.next_seq = None
+
+    def frame(self, payload):
+        if len(payload) < HEADER_BYTES:
+            return
+        seq, self.hz, lost = u16(payload, 0), u16(payload, 2), u16(payload, 4)
+        n = (len(payload) - HEADER_BYTES) // SAMPLE_BYTES
+        if self.next_seq is not None:
+            self.lost_link += (seq - self.next_seq) & 0xFFFF
+        self.next_seq = (seq + n) & 0xFFFF
+        self.lost_buffer += lost
+        for i in range(n):
+            pos = HEADER_BYTES + i * SAMPLE_BYTES
+            pc, lr = struct.unpack_from("<II", payload, pos)
+            self.samples.append((pc, lr, payload[pos + 8]))
+
+
+def print_report(profile, sym, top):
+    total = len(profile.samples)
+    duration = " (%.1f s a %d Hz)" % (total / profile.hz, profile.hz) if profile.hz else ""
+    print("%d amostras%s, perdidas: %d no buffer, %d na telemetria"
+          % (total, duration, profile.lost_buffer, profile.lost_link))
+    if not total:
+        return
+
+    funcs = Counter(sym.lookup(pc) for pc, _, _ in profile.samples)
+    print()
+    print("%8s %7s  %s" % ("amostras", "%", "função"))
+    for name, count in funcs.most_common(top):
+        print("%8d %6.2f%%  %s" % (count, 100.0 * count / total, name))
+    if len(funcs) > top:
+        rest = sum(c for _, c in funcs.most_common()[top:])
+        print("%8d %6.2f%%  (outras %d funções)" % (rest, 100.0 * rest / total, len(funcs) - top))
+
+    stages = Counter(stage for _, _, stage in profile.samples)
+    print()
+    print("%8s %7s  %s" % ("amostras", "%", "estágio"))
+    for stage, count in stages.most_common():
+        print("%8d %6.2f%%  %s" % (count, 100.0 * count / total, loop_stage(stage)))
+
+
+def folded_stacks(profile, sym):
+    stacks = Counter()
+    for pc, lr, stage in profile.samples:
+        func = sym.lookup(pc)
+        caller = sym.lookup(lr & ~1)
+        frames = [loop_stage(stage)]
+        # LR fora do código (EXC_RETURN, lixo) ou na própria função: sem chamador
+        if caller != func and not caller.startswith("["):
+            frames.append(caller)
+        frames.append(func)
+        stacks[";".join(frames)] += 1
+    return stacks
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("source", help="porta serial, arquivo gravado ou '-' para stdin")
+    ap.add_argument("--elf", required=True, help="ELF do alvo SnakeGame (build/SnakeGame.elf)")
+    ap.add_argument("--record", help="grava os bytes brutos recebidos neste arquivo")
+    ap.add_argument("--folded", help="grava as pilhas dobradas (flamegraph.pl/speedscope)")
+    ap.add_argument("--top", type=int, default=25, help="funções no perfil plano")
+    args = ap.parse_args()
+
+    with open(args.elf, "rb") as f:
+        try:
+            sym = Symbolizer(f.read())
+        except (ElfError, struct.error, ValueError, IndexError) as e:
+            print("%s: %s" % (args.elf, e), file=sys.stderr)
+            return 1
+
+    read = open_source(args.source)
+    is_stream = not (os.path.isfile(args.source) or args.source == "-")
+    record = open(args.record, "wb") if args.record else None
+    parser = FrameParser()
+    profile = Profile()
+    try:
+        while True:
+            data = read(4096)
+            if not data:
+                if is_stream:
+                    continue
+                frames = parser.flush()
+            else:
+                if record:
+                    record.write(data)
+                frames = parser.feed(data)
+            parser.text.clear()
+            for frame_type, payload in frames:
+                if frame_type == FRAME_PROFILE:
+                    profile.frame(payload)
+            if not data:
+                break
+    except KeyboardInterrupt:
+        pass
+    finally:
+        if record:
+            record.close()
+
+    print_report(profile, sym, args.top)
+    if args.folded:
+        with open(args.folded, "w") as f:
+            for stack, count in sorted(folded_stacks(profile, sym).items()):
+                f.write("%s %d\n" % (stack, count))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,191 @@
+#!/usr/bin/env python3
+"""Confere o tools/profile.py contra uma captura gravada e um ELF de referência.
+
+Roda o profile.py sobre tools/testdata/profile/capture.bin (quadros
+TLM_FRAME_PROFILE misturados com texto de printf, outros quadros, um quadro
+corrompido, um quadro perdido e amostras descartadas na placa) simbolizando
+com tools/testdata/profile/firmware.elf, e compara o perfil plano, a divisão
+por estágio e as pilhas dobradas com as saídas esperadas:
+
+    python3 tools/profile_check.py             # sai com erro e mostra o diff
+    python3 tools/profile_check.py --update    # aceita a saída atual
+    python3 tools/profile_check.py --regen     # recria o ELF e a captura
+
+O ELF é um ELF32 ARM mínimo (só a tabela de símbolos) com os casos que a
+simbolização precisa tratar: bit de Thumb, função na RAM, símbolo de tamanho
+zero, apelido no mesmo endereço, símbolo que não é função, endereços na ROM
+e fora de qualquer função. Não precisa da toolchain do alvo.
+"""
+
+import argparse
+import difflib
+import os
+import struct
+import subprocess
+import sys
+import tempfile
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from telemetry_decode import FRAME_PROFILE, FRAME_TICK, SYNC, crc8  # noqa: E402
+
+TOOLS = os.path.dirname(os.path.abspath(__file__))
+DATA = os.path.join(TOOLS, "testdata", "profile")
+ELF = os.path.join(DATA, "firmware.elf")
+CAPTURE = os.path.join(DATA, "capture.bin")
+EXPECTED_REPORT = os.path.join(DATA, "expected_report.txt")
+EXPECTED_FOLDED = os.path.join(DATA, "expected.folded")
+
+STT_FUNC = 2
+STT_OBJECT = 1
+STB_GLOBAL = 1
+EXC_RETURN = 0xFFFFFFF9
+
+# (nome, endereço com o bit de Thumb como no ELF do alvo, tamanho, tipo, seção)
+SYMBOLS = [
+    ("_entry_point", 0x100000F1, 0, STT_FUNC, 1),
+    ("snake_update", 0x10000101, 0x40, STT_FUNC, 1),
+    ("snake_draw", 0x10000141, 0x80, STT_FUNC, 1),
+    ("ssd1306_send_data", 0x100001C1, 0x60, STT_FUNC, 1),
+    ("i2c_write_blocking", 0x10000221, 0x30, STT_FUNC, 1),
+    ("__i2c_write_alias", 0x10000221, 0, STT_FUNC, 1),
+    ("ui_step", 0x10000251, 0x20, STT_FUNC, 1),
+    ("power_sleep_until", 0x10000271, 0x10, STT_FUNC, 1),
+    ("audio_mix", 0x20000001, 0x40, STT_FUNC, 2),
+    ("config", 0x20001000, 0x20, STT_OBJECT, 2),
+]
+
+# (pc, lr, estágio, repetições): estágios de deadline_stage_t
+SAMPLES = [
+    (0x10000110, 0x1000025B, 2, 9),    # update;ui_step;snake_update
+    (0x10000228, 0x100001E9, 3, 7),    # draw;ssd1306_send_data;i2c_write_blocking
+    (0x10000160, 0x10000171, 3, 4),    # LR na própria função: draw;snake_draw
+    (0x10000140, 0x1000025B, 3, 2),    # Primeira instrução: exige limpar o bit de Thumb
+    (0x00002ABC, 0x10000181, 3, 2),    # draw;snake_draw;[rom]
+    (0x20000010, EXC_RETURN, 7, 3),    # Interrupção do áudio durante o sono
+    (0x10000274, 0x10000265, 7, 2),    # sleep;ui_step;power_sleep_until
+    (0x100000F4, 0x00000000, 0, 1),    # Símbolo de tamanho zero
+    (0x10008000, 0x10000261, 6, 1),    # Fora de qualquer função
+    (0x10000104, 0x20001004, 9, 1),    # Estágio desconhecido; LR num objeto
+]
+HZ = 1000
+
+
+def build_elf():
+    strtab = b"\0"
+    names = []
+    for name, *_ in SYMBOLS:
+        names.append(len(strtab))
+        strtab += name.encode() + b"\0"
+    symtab = b"\0" * 16
+    for (name, value, size, kind, shndx), offset in zip(SYMBOLS, names):
+        symtab += struct.pack("<IIIBBH", offset, value, size, (STB_GLOBAL << 4) | kind, 0, shndx)
+    shstrtab = b"\0.text\0.data\0.symtab\0.strtab\0.shstrtab\0"
+
+    body = bytearray(52)
+    sections = [(0, 0, 0, 0, 0, 0, 0, 0)]
+
+    def add(name, kind, addr, data, link=0, info=0, entsize=0):
+        offset = len(body)
+        body.extend(data)
+        sections.append((shstrtab.index(name.encode() + b"\0"), kind, addr, offset, len(data),
+                         link, info, entsize))
+
+    add(".text", 8, 0x10000000, b"")       # SHT_NOBITS: só os endereços importam
+    add(".data", 8, 0x20000000, b"")
+    add(".symtab", 2, 0, symtab, link=4, info=1, entsize=16)
+    add(".strtab", 3, 0, strtab)
+    add(".shstrtab", 3, 0, shstrtab)
+    while len(body) % 4:
+        body.append(0)
+    shoff = len(body)
+    for name, kind, addr, offset, size, link, info, entsize in sections:
+        body += struct.pack("<IIIIIIIIII", name, kind, 0, addr, offset, size, link, info, 4, entsize)
+    ident = b"\x7fELF" + bytes([1, 1, 1]) + b"\0" * 9
+    body[:52] = ident + struct.pack("<HHIIIIIHHHHHH", 2, 40, 1, 0x100000F1, 0, shoff, 0x05000200,
+                                    52, 0, 0, 40, len(sections), len(sections) - 1)
+    return bytes(body)
+
+
+def frame(frame_type, payload):
+    body = bytes([frame_type, len(payload)]) + payload
+    return bytes([SYNC]) + body + bytes([crc8(body)])
+
+
+def profile_frame(seq, lost, samples):
+    payload = struct.pack("<HHH", seq, HZ, lost)
+    for pc, lr, stage in samples:
+        payload += struct.pack("<IIB", pc, lr, stage)
+    return frame(FRAME_PROFILE, payload)
+
+
+def build_capture():
+    samples = [(pc, lr, stage) for pc, lr, stage, n in SAMPLES for _ in range(n)]
+    # Espalha os casos entre os quadros, de forma determinística
+    samples = samples[::2] + samples[1::2]
+    first, second, third = samples[:12], samples[12:20], samples[20:]
+    out = b"SnakeGame: boot\r\n"
+    out += profile_frame(0, 0, first)
+    out += frame(FRAME_TICK, bytes([1, 0, 0]))
+    out += b"snapshot: 74 bytes gravados em 812 us\r\n"
+    out += profile_frame(len(first), 3, second)
+    # Quadro corrompido no caminho (CRC errado): conta como perdido na telemetria
+    bad = bytearray(profile_frame(len(first) + len(second), 0, [(0x10000110, 0, 2)] * 5))
+    bad[-1] ^= 0xFF
+    out += bytes(bad)
+    out += profile_frame(len(first) + len(second) + 5, 0, third)
+    return out
+
+
+def run_profile():
+    with tempfile.TemporaryDirectory() as tmp:
+        folded = os.path.join(tmp, "perfil.folded")
+        result = subprocess.run([sys.executable, os.path.join(TOOLS, "profile.py"), CAPTURE,
+                                 "--elf", ELF, "--folded", folded],
+                                stdout=subprocess.PIPE, stderr=subprocess.STDOUT, universal_newlines=True)
+        if result.returncode:
+            sys.stdout.write(result.stdout)
+            raise SystemExit("profile.py falhou (código %d)" % result.returncode)
+        with open(folded) as f:
+            return result.stdout, f.read()
+
+
+def compare(path, actual):
+    with open(path) as f:
+        expected = f.read()
+    if expected == actual:
+        return True
+    name = os.path.relpath(path, os.path.dirname(TOOLS))
+    sys.stdout.writelines(difflib.unified_diff(expected.splitlines(True), actual.splitlines(True),
+                                               name, "saída atual"))
+    return False
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("--update", action="store_true", help="grava a saída atual como a esperada")
+    ap.add_argument("--regen", action="store_true", help="recria o ELF e a captura (implica --update)")
+    args = ap.parse_args()
+
+    if args.regen:
+        os.makedirs(DATA, exist_ok=True)
+        with open(ELF, "wb") as f:
+            f.write(build_elf())
+        with open(CAPTURE, "wb") as f:
+            f.write(build_capture())
+
+    report, folded = run_profile()
+    if args.update or args.regen:
+        for path, content in ((EXPECTED_REPORT, report), (EXPECTED_FOLDED, folded)):
+            with open(path, "w") as f:
+                f.write(content)
+        print("saídas esperadas gravadas em %s" % os.path.relpath(DATA, os.path.dirname(TOOLS)))
+        return 0
+
+    ok = compare(EXPECTED_REPORT, report)
+    ok = compare(EXPECTED_FOLDED, folded) and ok
+    print("profile: ok" if ok else "profile: saída diferente da esperada")
+    return 0 if ok else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
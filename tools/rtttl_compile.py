@@ -0,0 +1,181 @@
+#!/usr/bin/env python3
+"""Compila melodias RTTTL para o bytecode tocado pelo motor de áudio.
+
+Cada arquivo .rtttl vira um array const na flash (melody_<nome>) em
+melodies.c/melodies.h, gerados no diretório de saída:
+
+    python3 tools/rtttl_compile.py -o build/generated assets/sounds/*.rtttl
+
+Formato RTTTL: "nome:d=4,o=5,b=120:8c6,8p,4e.,..." com três extensões na lista
+de notas: "@mark" marca o ponto de retorno, "@loop" volta para a marca (ou para
+o início) e "@b=NNN" muda o andamento no meio da música. Linhas começando
+com '#' são comentários.
+
+Bytecode (um byte por nota na maioria dos casos):
+    0x00-0xBF  nota: (classe de duração << 5) | índice
+               classe 0..5 = semibreve..fusa (1/1..1/32); índice 0 = pausa,
+               1..31 = semitons acima da base (índice 1 = base)
+    0xC0       END
+    0xC1       LOOP (volta para a marca ou para o início)
+    0xC2       MARK
+    0xC3       DOT (a próxima nota dura 1,5x)
+    0xC4 hi lo TEMPO em bpm (u16)
+    0xC5 n     BASE: nota MIDI do índice 1
+"""
+
+import argparse
+import os
+import re
+import sys
+
+OP_END = 0xC0
+OP_LOOP = 0xC1
+OP_MARK = 0xC2
+OP_DOT = 0xC3
+OP_TEMPO = 0xC4
+OP_BASE = 0xC5
+
+DURATIONS = {1: 0, 2: 1, 4: 2, 8: 3, 16: 4, 32: 5}
+SEMITONES = {"c": 0, "c#": 1, "d": 2, "d#": 3, "e": 4, "f": 5, "f#": 6,
+             "g": 7, "g#": 8, "a": 9, "a#": 10, "b": 11, "h": 11}
+NOTE = re.compile(r"^(\d+)?([a-hp]#?)(\.)?(\d)?(\.)?$")
+MAX_INDEX = 31
+
+
+class RtttlError(Exception):
+    pass
+
+
+def parse_defaults(text):
+    defaults = {"d": 4, "o": 6, "b": 63}
+    for item in filter(None, (p.strip() for p in text.split(","))):
+        key, _, value = item.partition("=")
+        if key not in defaults or not value.isdigit():
+            raise RtttlError("padrão inválido: %r" % item)
+        defaults[key] = int(value)
+    return defaults
+
+
+def check_bpm(bpm, token):
+    # b=0 zeraria a duração das notas no motor (uma amostra cada)
+    if not 0 < bpm <= 0xFFFF:
+        raise RtttlError("andamento fora da faixa (1..65535): %r" % token)
+    return bpm
+
+
+def compile_rtttl(text):
+    """Retorna (nome, bytecode) de uma melodia RTTTL."""
+    lines = [l for l in text.splitlines() if not l.lstrip().startswith("#")]
+    text = re.sub(r"\s+", "", "".join(lines))
+    parts = text.split(":", 2)
+    if len(parts) != 3:
+        raise RtttlError("esperado 'nome:padrões:notas'")
+    name, defaults, notes = parts
+    defaults = parse_defaults(defaults)
+    if defaults["d"] not in DURATIONS:
+        raise RtttlError("duração padrão inválida: %d" % defaults["d"])
+
+    tempo = check_bpm(defaults["b"], "b=%d" % defaults["b"])
+    code = [OP_TEMPO, tempo >> 8, tempo & 0xFF]
+    base = None
+    looped = False
+    for token in filter(None, notes.lower().split(",")):
+        if looped:
+            raise RtttlError("%r depois de @loop nunca toca" % token)
+        if token == "@mark":
+            # O LOOP volta para cá com a BASE e o TEMPO do fim da música:
+            # reafirma o andamento e força uma BASE na próxima nota
+            code += [OP_MARK, OP_TEMPO, tempo >> 8, tempo & 0xFF]
+            base = None
+            continue
+        if token == "@loop":
+            code.append(OP_LOOP)
+            looped = True
+            continue
+        if token.startswith("@b="):
+            if not token[3:].isdigit():
+                raise RtttlError("andamento inválido: %r" % token)
+            tempo = check_bpm(int(token[3:]), token)
+            code += [OP_TEMPO, tempo >> 8, tempo & 0xFF]
+            continue
+        m = NOTE.match(token)
+        if not m:
+            raise RtttlError("nota inválida: %r" % token)
+        duration = int(m.group(1) or defaults["d"])
+        if duration not in DURATIONS:
+            raise RtttlError("duração inválida: %r" % token)
+        if m.group(3) or m.group(5):
+            code.append(OP_DOT)
+        klass = DURATIONS[duration] << 5
+        if m.group(2) == "p":
+            code.append(klass)
+            continue
+        octave = int(m.group(4) or defaults["o"])
+        midi = 12 * (octave + 1) + SEMITONES[m.group(2)]
+        if midi > 127:
+            raise RtttlError("nota fora da faixa: %r" % token)
+        # A janela de 31 semitons só é deslocada quando a nota cai fora dela
+        if base is None or not (base <= midi < base + MAX_INDEX):
+            base = max(0, min(midi - 12, 127 - MAX_INDEX + 1))
+            code += [OP_BASE, base]
+        code.append(klass | (midi - base + 1))
+    if OP_LOOP not in code:
+        code.append(OP_END)
+    return name, code
+
+
+def c_identifier(name):
+    ident = re.sub(r"\W", "_", name.lower())
+    return ident if not ident[:1].isdigit() else "_" + ident
+
+
+def write_outputs(out_dir, melodies):
+    os.makedirs(out_dir, exist_ok=True)
+    header = ["// Gerado por tools/rtttl_compile.py a partir de assets/sounds -- não editar",
+              "#ifndef MELODIES_H", "#define MELODIES_H", "", "#include <stdint.h>", ""]
+    source = ["// Gerado por tools/rtttl_compile.py a partir de assets/sounds -- não editar",
+              '#include "melodies.h"', ""]
+    for ident, src, code in melodies:
+        header.append("extern const uint8_t melody_%s[%d];" % (ident, len(code)))
+        source.append("// %s" % src)
+        source.append("const uint8_t melody_%s[%d] = {" % (ident, len(code)))
+        for i in range(0, len(code), 12):
+            source.append("    " + ", ".join("0x%02X" % b for b in code[i:i + 12]) + ",")
+        source.append("};")
+        source.append("")
+    header += ["", "#endif // MELODIES_H", ""]
+    for fname, lines in (("melodies.h", header), ("melodies.c", source)):
+        path = os.path.join(out_dir, fname)
+        content = "\n".join(lines)
+        # Não reescreve arquivos iguais, para não recompilar à toa
+        if os.path.exists(path) and open(path).read() == content:
+            continue
+        with open(path, "w") as f:
+            f.write(content)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("sources", nargs="+", help="arquivos .rtttl")
+    ap.add_argument("-o", "--out", required=True, help="diretório de saída")
+    args = ap.parse_args()
+
+    melodies = []
+    total = 0
+    for path in sorted(args.sources):
+        with open(path) as f:
+            try:
+                _, code = compile_rtttl(f.read())
+            except RtttlError as e:
+                print("%s: %s" % (path, e), file=sys.stderr)
+                return 1
+        ident = c_identifier(os.path.splitext(os.path.basename(path))[0])
+        melodies.append((ident, os.path.basename(path), code))
+        total += len(code)
+    write_outputs(args.out, melodies)
+    print("%d melodias, %d bytes de bytecode" % (len(melodies), total))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,278 @@
+#!/usr/bin/env python3
+"""Compila os sprites (assets/sprites/*.pbm, *.png) para um atlas const na flash.
+
+Gera sprites.c/sprites.h no diretório de saída:
+
+    python3 tools/sprite_compile.py -o build/generated assets/sprites/*.pbm
+
+Cada sprite é um PBM de texto (P1) ou um PNG de 8x8. No PNG, pixel aceso é o
+escuro e opaco (como a tinta do PBM); valem tons de cinza, RGB, paleta e
+transparência, sem entrelaçamento. As peças das cobras seguem o nome
+<conjunto>_<peça>.pbm (p1_head, p2_corner, ...), desenhadas numa só orientação:
+
+    head        cabeça olhando para a direita
+    tail        cauda andando para a direita (ponta à esquerda)
+    straight    corpo reto na horizontal
+    corner      curva ligando a esquerda e baixo
+
+As outras orientações (cabeça e cauda x4, reto x2, curva x4) são geradas aqui
+por rotação, então o jogo só indexa uma tabela. Os demais arquivos (food,
+wall) viram sprites avulsos. Tudo sai no formato das páginas do SSD1306: um
+byte por coluna, bit 0 em cima.
+"""
+
+import argparse
+import os
+import struct
+import sys
+import zlib
+
+SIZE = 8
+PIECES = ("head", "tail", "straight", "corner")
+# Mesma ordem do enum Direction (Snake.h): sentido horário na tela
+RIGHT, DOWN, LEFT, UP = range(4)
+NAMES = {RIGHT: "direita", DOWN: "baixo", LEFT: "esquerda", UP: "cima"}
+TILE_HEAD, TILE_TAIL, TILE_STRAIGHT_H, TILE_STRAIGHT_V, TILE_CORNER = 0, 4, 8, 9, 10
+SNAKE_TILES = 14
+
+
+class SpriteError(Exception):
+    pass
+
+
+def parse_pbm(text):
+    tokens = []
+    for line in text.splitlines():
+        tokens += line.split("#")[0].split()
+    if not tokens or tokens[0] != "P1":
+        raise SpriteError("só PBM de texto (P1)")
+    width, height = int(tokens[1]), int(tokens[2])
+    if (width, height) != (SIZE, SIZE):
+        raise SpriteError("sprite de %dx%d (precisa ser %dx%d)" % (width, height, SIZE, SIZE))
+    # Os bits podem vir separados ou colados ("0110...")
+    bits = [c for tok in tokens[3:] for c in tok]
+    if len(bits) != SIZE * SIZE or any(c not in "01" for c in bits):
+        raise SpriteError("esperava %d bits 0/1" % (SIZE * SIZE))
+    return [[bits[y * SIZE + x] == "1" for x in range(SIZE)] for y in range(SIZE)]
+
+
+def png_rows(data):
+    """Linhas de amostras do PNG, já sem os filtros, e os parâmetros do IHDR."""
+    if data[:8] != b"\x89PNG\r\n\x1a\n":
+        raise SpriteError("não é um PNG")
+    pos, ihdr, palette, trns, idat = 8, None, None, None, b""
+    while pos < len(data):
+        length, kind = struct.unpack(">I4s", data[pos:pos + 8])
+        body = data[pos + 8:pos + 8 + length]
+        pos += 12 + length
+        if kind == b"IHDR":
+            ihdr = struct.unpack(">IIBBBBB", body)
+        elif kind == b"PLTE":
+            palette = [tuple(body[i:i + 3]) for i in range(0, len(body), 3)]
+        elif kind == b"tRNS":
+            trns = body
+        elif kind == b"IDAT":
+            idat += body
+        elif kind == b"IEND":
+            break
+    if ihdr is None:
+        raise SpriteError("PNG sem IHDR")
+    width, height, depth, color, _, _, interlace = ihdr
+    if (width, height) != (SIZE, SIZE):
+        raise SpriteError("sprite de %dx%d (precisa ser %dx%d)" % (width, height, SIZE, SIZE))
+    channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}.get(color)
+    if channels is None or interlace or (depth != 8 and color not in (0, 3)) or depth not in (1, 2, 4, 8):
+        raise SpriteError("PNG de cor %d, %d bits%s não suportado"
+                          % (color, depth, ", entrelaçado" if interlace else ""))
+    if color == 3 and palette is None:
+        raise SpriteError("PNG com paleta sem PLTE")
+
+    raw = zlib.decompress(idat)
+    stride = (width * channels * depth + 7) // 8
+    bpp = max(1, channels * depth // 8)
+    rows, prev = [], bytearray(stride)
+    for y in range(height):
+        kind, line = raw[y * (stride + 1)], bytearray(raw[y * (stride + 1) + 1:(y + 1) * (stride + 1)])
+        for i in range(stride):
+            a = line[i - bpp] if i >= bpp else 0
+            b, c = prev[i], prev[i - bpp] if i >= bpp else 0
+            if kind == 1:
+                line[i] = (line[i] + a) & 0xFF
+            elif kind == 2:
+                line[i] = (line[i] + b) & 0xFF
+            elif kind == 3:
+                line[i] = (line[i] + (a + b) // 2) & 0xFF
+            elif kind == 4:
+                p = a + b - c
+                pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+                line[i] = (line[i] + (a if pa <= pb and pa <= pc else b if pb <= pc else c)) & 0xFF
+            elif kind != 0:
+                raise SpriteError("filtro PNG %d inválido" % kind)
+        rows.append([(line[(i * depth) // 8] >> (8 - depth - (i * depth) % 8)) & ((1 << depth) - 1)
+                     for i in range(width * channels)])
+        prev = line
+    return rows, depth, color, channels, palette, trns
+
+
+def parse_png(data):
+    rows, depth, color, channels, palette, trns = png_rows(data)
+    scale = 255 // ((1 << depth) - 1)
+    pixels = []
+    for row in rows:
+        out = []
+        for x in range(SIZE):
+            s = row[x * channels:(x + 1) * channels]
+            if color == 3:
+                r, g, b = palette[s[0]]
+                alpha = trns[s[0]] if trns and s[0] < len(trns) else 255
+            else:
+                r, g, b = (s[0], s[0], s[0]) if color in (0, 4) else s[:3]
+                r, g, b = r * scale, g * scale, b * scale
+                alpha = s[-1] if color in (4, 6) else 255
+            # Luminância (Rec. 601) abaixo do meio e pixel mais opaco que transparente
+            out.append(alpha >= 128 and (299 * r + 587 * g + 114 * b) < 128 * 1000)
+        pixels.append(out)
+    return pixels
+
+
+def rotate(pixels, turns):
+    """Gira no sentido horário da tela (y para baixo), 'turns' vezes 90 graus."""
+    for _ in range(turns % 4):
+        pixels = [[pixels[SIZE - 1 - x][y] for x in range(SIZE)] for y in range(SIZE)]
+    return pixels
+
+
+def page_bytes(pixels):
+    return [sum(1 << y for y in range(SIZE) if pixels[y][x]) for x in range(SIZE)]
+
+
+def snake_tiles(pieces):
+    tiles = [None] * SNAKE_TILES
+    for d in range(4):
+        tiles[TILE_HEAD + d] = ("cabeça, %s" % NAMES[d], rotate(pieces["head"], d))
+        tiles[TILE_TAIL + d] = ("cauda, %s" % NAMES[d], rotate(pieces["tail"], d))
+        tiles[TILE_CORNER + d] = ("curva %s-%s" % (NAMES[(LEFT + d) % 4], NAMES[(DOWN + d) % 4]),
+                                  rotate(pieces["corner"], d))
+    tiles[TILE_STRAIGHT_H] = ("reto, horizontal", pieces["straight"])
+    tiles[TILE_STRAIGHT_V] = ("reto, vertical", rotate(pieces["straight"], 1))
+    return tiles
+
+
+def segment_table():
+    """Peça do meio do corpo pelas direções até os dois vizinhos."""
+    table = [[TILE_STRAIGHT_H] * 4 for _ in range(4)]
+    for a in range(4):
+        for b in range(4):
+            if a == b:
+                continue  # Vizinhos na mesma célula: não acontece
+            if (a - b) % 4 == 2:
+                table[a][b] = TILE_STRAIGHT_H if a in (RIGHT, LEFT) else TILE_STRAIGHT_V
+                continue
+            for k in range(4):
+                if {(LEFT + k) % 4, (DOWN + k) % 4} == {a, b}:
+                    table[a][b] = TILE_CORNER + k
+    return table
+
+
+def c_bytes(values):
+    return "{" + ", ".join("0x%02X" % v for v in values) + "}"
+
+
+def write_outputs(out_dir, sets, singles):
+    os.makedirs(out_dir, exist_ok=True)
+    banner = "// Gerado por tools/sprite_compile.py a partir de assets/sprites -- não editar"
+    header = [banner, "#ifndef SPRITES_H", "#define SPRITES_H", "", "#include <stdint.h>", "",
+              "// Peças de cada cobra (8 bytes, um por coluna, bit 0 em cima)",
+              "#define SPRITE_HEAD %d        // + direção da cabeça (RIGHT, DOWN, LEFT, UP)" % TILE_HEAD,
+              "#define SPRITE_TAIL %d        // + direção em que a cauda anda" % TILE_TAIL,
+              "#define SPRITE_STRAIGHT_H %d" % TILE_STRAIGHT_H,
+              "#define SPRITE_STRAIGHT_V %d" % TILE_STRAIGHT_V,
+              "#define SPRITE_CORNER %d     // + giro: esquerda-baixo, cima-esquerda, direita-cima, baixo-direita"
+              % TILE_CORNER,
+              "#define SPRITE_SNAKE_TILES %d" % SNAKE_TILES,
+              "#define SPRITE_SETS %d" % len(sets), "",
+              "extern const uint8_t sprite_snake[SPRITE_SETS][SPRITE_SNAKE_TILES][8];",
+              "// Peça de um segmento do meio: [direção até o vizinho da frente][até o de trás]",
+              "extern const uint8_t sprite_segment[4][4];"]
+    header += ["extern const uint8_t sprite_%s[8];" % name for name, _ in singles]
+    header += ["", "#endif // SPRITES_H", ""]
+
+    source = [banner, '#include "sprites.h"', "",
+              "// const: fica na flash e é lido pela XIP",
+              "const uint8_t sprite_snake[SPRITE_SETS][SPRITE_SNAKE_TILES][8] = {"]
+    for name, tiles in sets:
+        source.append("    // %s" % name)
+        source.append("    {")
+        for desc, pixels in tiles:
+            source.append("        %s,  // %s" % (c_bytes(page_bytes(pixels)), desc))
+        source.append("    },")
+    source += ["};", "", "const uint8_t sprite_segment[4][4] = {"]
+    source += ["    {%s}," % ", ".join("%d" % t for t in row) for row in segment_table()]
+    source += ["};", ""]
+    for name, pixels in singles:
+        source.append("const uint8_t sprite_%s[8] = %s;" % (name, c_bytes(page_bytes(pixels))))
+    source.append("")
+
+    for fname, lines in (("sprites.h", header), ("sprites.c", source)):
+        path = os.path.join(out_dir, fname)
+        content = "\n".join(lines)
+        # Não reescreve arquivos iguais, para não recompilar à toa
+        if os.path.exists(path) and open(path).read() == content:
+            continue
+        with open(path, "w") as f:
+            f.write(content)
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("sources", nargs="+", help="arquivos .pbm ou .png")
+    ap.add_argument("-o", "--out", required=True, help="diretório de saída")
+    args = ap.parse_args()
+
+    pieces = {}
+    singles = []
+    for path in sorted(args.sources):
+        stem, ext = os.path.splitext(os.path.basename(path))
+        try:
+            if ext.lower() == ".png":
+                with open(path, "rb") as f:
+                    pixels = parse_png(f.read())
+            else:
+                with open(path) as f:
+                    pixels = parse_pbm(f.read())
+        except (SpriteError, ValueError, IndexError, struct.error, zlib.error) as e:
+            print("%s: %s" % (path, e), file=sys.stderr)
+            return 1
+        prefix, _, piece = stem.rpartition("_")
+        if prefix and piece in PIECES:
+            pieces.setdefault(prefix, {})[piece] = pixels
+        elif stem.isidentifier():
+            singles.append((stem, pixels))
+        else:
+            print("%s: nome inválido para um sprite" % path, file=sys.stderr)
+            return 1
+
+    sets = []
+    for prefix in sorted(pieces):
+        missing = [p for p in PIECES if p not in pieces[prefix]]
+        if missing:
+            print("conjunto %s: faltam %s" % (prefix, ", ".join(missing)), file=sys.stderr)
+            return 1
+        sets.append((prefix, snake_tiles(pieces[prefix])))
+    if not sets:
+        print("nenhum conjunto de peças de cobra", file=sys.stderr)
+        return 1
+
+    write_outputs(args.out, sets, singles)
+    # Tamanho de cada asset na flash, para acompanhar o que cada arquivo custa
+    for name, _ in sets:
+        print("  cobra %-10s %4d bytes (%d peças)" % (name, SNAKE_TILES * SIZE, SNAKE_TILES))
+    for name, _ in singles:
+        print("  sprite %-9s %4d bytes" % (name, SIZE))
+    size = len(sets) * SNAKE_TILES * SIZE + 16 + len(singles) * SIZE
+    print("%d conjuntos de peças, %d sprites avulsos, %d bytes na flash" % (len(sets), len(singles), size))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
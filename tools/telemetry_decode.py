@@ -0,0 +1,252 @@
+#!/usr/bin/env python3
+"""Decodificador da telemetria binária do SnakeGame.
+
+Lê o fluxo do USB CDC (porta serial, arquivo gravado ou stdin), separa os
+quadros [SYNC][tipo][tamanho][payload][crc8] do texto de printf que divide a
+mesma porta e imprime cada quadro em formato legível.
+
+    python3 tools/telemetry_decode.py /dev/ttyACM0
+    python3 tools/telemetry_decode.py captura.bin --record copia.bin
+
+Ler de uma porta serial requer o pacote pyserial.
+"""
+
+import argparse
+import os
+import sys
+
+SYNC = 0xA5
+
+FRAME_TICK = 0x01
+FRAME_EVENT = 0x02
+FRAME_TIMING = 0x03
+FRAME_FB_PAGE = 0x04
+FRAME_FB_END = 0x05
+FRAME_PROFILE = 0x06
+
+TICK_HEAD = 0x01
+TICK_DIR = 0x02
+TICK_LENGTH = 0x04
+TICK_SCORE = 0x08
+TICK_FOOD = 0x10
+
+EVENTS = {1: "food", 2: "death", 3: "score", 4: "reset", 5: "overrun", 6: "watchdog",
+          7: "remote"}
+REMOTE_RESULTS = {0: "applied", 1: "rejected", 2: "dropped", 3: "flushed"}
+DIRECTIONS = {0: "RIGHT", 1: "DOWN", 2: "LEFT", 3: "UP"}
+STAGES = ["input", "update", "draw", "audio"]
+# Estágios do monitor de prazos (deadline_stage_t)
+LOOP_STAGES = ["loop", "input", "update", "draw", "audio", "ui", "idle", "sleep"]
+
+
+def _crc8_table():
+    table = []
+    for i in range(256):
+        crc = i
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x07) & 0xFF if crc & 0x80 else (crc << 1) & 0xFF
+        table.append(crc)
+    return table
+
+
+_CRC8 = _crc8_table()
+
+
+def crc8(data, crc=0):
+    for b in data:
+        crc = _CRC8[crc ^ b]
+    return crc
+
+
+class FrameParser:
+    """Separa quadros válidos de um fluxo de bytes, ressincronizando no SYNC.
+
+    Bytes fora de quadros (texto de printf) são acumulados em `text`.
+    """
+
+    def __init__(self):
+        self.buf = bytearray()
+        self.text = bytearray()
+        self.bad_crc = 0
+
+    def feed(self, data):
+        self.buf.extend(data)
+        frames = []
+        while True:
+            start = self.buf.find(bytes([SYNC]))
+            if start < 0:
+                self.text.extend(self.buf)
+                self.buf.clear()
+                break
+            if start:
+                self.text.extend(self.buf[:start])
+                del self.buf[:start]
+            if len(self.buf) < 3:
+                break
+            length = self.buf[2]
+            total = 4 + length
+            if len(self.buf) < total:
+                break
+            body = bytes(self.buf[1:3 + length])
+            if crc8(body) == self.buf[3 + length]:
+                frames.append((body[0], body[2:]))
+                del self.buf[:total]
+            else:
+                # Não era um quadro: o SYNC fazia parte do texto
+                self.bad_crc += 1
+                self.text.append(self.buf[0])
+                del self.buf[:1]
+        return frames
+
+    def flush(self):
+        """No fim do arquivo: um SYNC falso com tamanho grande pode estar retendo
+        quadros reais; descarta-o e reprocessa o restante."""
+        frames = []
+        while self.buf:
+            self.text.append(self.buf[0])
+            del self.buf[:1]
+            frames.extend(self.feed(b""))
+        return frames
+
+
+def u16(data, pos):
+    return data[pos] | (data[pos + 1] << 8)
+
+
+def decode_tick(p):
+    tick, mask = u16(p, 0), p[2]
+    pos = 3
+    fields = []
+    if mask & TICK_HEAD:
+        fields.append("head=(%d,%d)" % (p[pos], p[pos + 1]))
+        pos += 2
+    if mask & TICK_DIR:
+        fields.append("dir=%s" % DIRECTIONS.get(p[pos], p[pos]))
+        pos += 1
+    if mask & TICK_LENGTH:
+        fields.append("len=%d" % p[pos])
+        pos += 1
+    if mask & TICK_SCORE:
+        fields.append("score=%d" % u16(p, pos))
+        pos += 2
+    if mask & TICK_FOOD:
+        fields.append("food=(%d,%d)" % (p[pos], p[pos + 1]))
+        pos += 2
+    return "tick %5d  %s" % (tick, " ".join(fields))
+
+
+def loop_stage(i):
+    return LOOP_STAGES[i] if i < len(LOOP_STAGES) else "stage%d" % i
+
+
+def decode_event(p):
+    tick, event, data = u16(p, 0), p[2], p[3:]
+    name = EVENTS.get(event, "event%d" % event)
+    if name == "food":
+        detail = "at (%d,%d)" % (data[0], data[1])
+    elif name == "death":
+        detail = "score=%d len=%d" % (u16(data, 0), data[2])
+    elif name == "score":
+        detail = "score=%d" % u16(data, 0)
+    elif name == "overrun":
+        late = u16(data, 1) | (u16(data, 3) << 16)
+        detail = "stage=%s late=%dus" % (loop_stage(data[0]), late)
+    elif name == "watchdog":
+        detail = "stage=%s frame=%d" % (loop_stage(data[0]), u16(data, 1))
+    elif name == "remote":
+        latency = u16(data, 2) | (u16(data, 4) << 16)
+        detail = "seq=%d %s latency=%dus" % (data[0], REMOTE_RESULTS.get(data[1], "?"), latency)
+    else:
+        detail = data.hex()
+    return "tick %5d  EVENT %s %s" % (tick, name, detail)
+
+
+def decode_timing(p):
+    tick, count = u16(p, 0), p[2]
+    parts = []
+    for i in range(count):
+        name = STAGES[i] if i < len(STAGES) else "stage%d" % i
+        parts.append("%s=%dus" % (name, u16(p, 3 + 2 * i)))
+    return "tick %5d  TIMING %s" % (tick, " ".join(parts))
+
+
+def decode_fb_page(p):
+    seq, page = u16(p, 0), p[2]
+    kind = "key" if page & 0x80 else "delta"
+    return "fb %5d  page %d %s %d bytes" % (seq, page & 0x7F, kind, len(p) - 3)
+
+
+def decode_fb_end(p):
+    return "fb %5d  END %dx%d changed=0x%02x" % (u16(p, 0), p[2], p[3] * 8, p[4])
+
+
+def decode_profile(p):
+    seq, hz, lost = u16(p, 0), u16(p, 2), u16(p, 4)
+    n = (len(p) - 6) // 9
+    return "prof %5d  %d samples @ %dHz lost=%d" % (seq, n, hz, lost)
+
+
+DECODERS = {
+    FRAME_TICK: decode_tick,
+    FRAME_EVENT: decode_event,
+    FRAME_TIMING: decode_timing,
+    FRAME_FB_PAGE: decode_fb_page,
+    FRAME_FB_END: decode_fb_end,
+    FRAME_PROFILE: decode_profile,
+}
+
+
+def decode(frame_type, payload):
+    fn = DECODERS.get(frame_type)
+    if fn is None:
+        return "frame 0x%02x %s" % (frame_type, payload.hex())
+    return fn(payload)
+
+
+def open_source(path, baud=115200):
+    """Retorna uma função read(n) para stdin, arquivo ou porta serial."""
+    if path == "-":
+        return sys.stdin.buffer.read1 if hasattr(sys.stdin.buffer, "read1") else sys.stdin.buffer.read
+    if os.path.isfile(path):
+        return open(path, "rb").read
+    import serial  # pyserial
+    port = serial.Serial(path, baud, timeout=0.1)
+    return port.read
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("source", help="porta serial, arquivo gravado ou '-' para stdin")
+    ap.add_argument("--record", help="grava os bytes brutos recebidos neste arquivo")
+    ap.add_argument("--text", action="store_true", help="mostra também o texto de printf")
+    args = ap.parse_args()
+
+    read = open_source(args.source)
+    record = open(args.record, "wb") if args.record else None
+    parser = FrameParser()
+    is_file = os.path.isfile(args.source)
+    try:
+        while True:
+            data = read(4096)
+            if not data:
+                if is_file or args.source == "-":
+                    for frame_type, payload in parser.flush():
+                        print(decode(frame_type, payload))
+                    break
+                continue
+            if record:
+                record.write(data)
+            for frame_type, payload in parser.feed(data):
+                print(decode(frame_type, payload))
+            if args.text and parser.text:
+                sys.stdout.write(parser.text.decode("utf-8", "replace"))
+            parser.text.clear()
+    except KeyboardInterrupt:
+        pass
+    finally:
+        if record:
+            record.close()
+
+
+if __name__ == "__main__":
+    main()